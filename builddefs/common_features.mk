@@ -428,6 +428,7 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
     ifeq ($(strip $(LED_MATRIX_DRIVER)), snled27351)
         I2C_DRIVER_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led
+        COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += snled27351-mono.c
     endif
 
@@ -537,6 +538,7 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), snled27351)
         I2C_DRIVER_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led
+        COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += snled27351.c
     endif
 
@@ -624,6 +626,13 @@ ifeq ($(strip $(VIAL_ENABLE)), yes)
     include $(BUILDDEFS_PATH)/build_vial.mk
 endif
 
+ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
+    ifeq ($(strip $(DYNAMIC_KEYMAP_RAM_MIRROR)), yes)
+        OPT_DEFS += -DDYNAMIC_KEYMAP_RAM_MIRROR
+        DEFERRED_EXEC_ENABLE := yes
+    endif
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -36,6 +36,7 @@ GENERIC_FEATURES = \
     HAPTIC \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LEADER \
     MAGIC \
     MOUSEKEY \
@@ -43,6 +44,7 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    SCAN_PROFILE \
     SECURE \
     SEND_STRING \
     SEQUENCER \
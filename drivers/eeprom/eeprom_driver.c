@@ -49,11 +49,44 @@ void eeprom_write_dword(uint32_t *addr, uint32_t value) {
     eeprom_write_block(&value, addr, 4);
 }
 
+// eeprom_update_block() compares against the current contents this many bytes at a time
+#ifndef EEPROM_UPDATE_BLOCK_CHUNK_SIZE
+#    define EEPROM_UPDATE_BLOCK_CHUNK_SIZE 32
+#endif
+
+// Changed bytes separated by at most this many unchanged ones are written
+// together, as one larger write is cheaper than starting another.
+#ifndef EEPROM_UPDATE_BLOCK_GAP
+#    define EEPROM_UPDATE_BLOCK_GAP 8
+#endif
+
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
-    uint8_t read_buf[len];
-    eeprom_read_block(read_buf, addr, len);
-    if (memcmp(buf, read_buf, len) != 0) {
-        eeprom_write_block(buf, addr, len);
+    const uint8_t *src = buf;
+    uint8_t       *dst = addr;
+    uint8_t        read_buf[EEPROM_UPDATE_BLOCK_CHUNK_SIZE];
+    size_t         run_start = 0;
+    size_t         run_end   = 0; // the pending run of changed bytes, empty while run_end == run_start
+
+    for (size_t offset = 0; offset < len; offset += sizeof(read_buf)) {
+        size_t size = len - offset < sizeof(read_buf) ? len - offset : sizeof(read_buf);
+        eeprom_read_block(read_buf, dst + offset, size);
+        for (size_t i = 0; i < size; i++) {
+            if (src[offset + i] == read_buf[i]) {
+                continue;
+            }
+            if (run_end != run_start && offset + i - run_end > EEPROM_UPDATE_BLOCK_GAP) {
+                eeprom_write_block(src + run_start, dst + run_start, run_end - run_start);
+                run_end = run_start;
+            }
+            if (run_end == run_start) {
+                run_start = offset + i;
+            }
+            run_end = offset + i + 1;
+        }
+    }
+
+    if (run_end != run_start) {
+        eeprom_write_block(src + run_start, dst + run_start, run_end - run_start);
     }
 }
 
@@ -18,6 +18,17 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     wear_leveling_read((uint32_t)addr, buf, len);
 }
 
+// Writes longer than this are logged as a single extent rather than as multiple small entries
+#ifndef EEPROM_WEAR_LEVELING_EXTENT_THRESHOLD
+#    define EEPROM_WEAR_LEVELING_EXTENT_THRESHOLD 8
+#endif
+
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    if (len > EEPROM_WEAR_LEVELING_EXTENT_THRESHOLD) {
+        wear_leveling_begin();
+        wear_leveling_write((uint32_t)addr, buf, len);
+        wear_leveling_commit();
+        return;
+    }
     wear_leveling_write((uint32_t)addr, buf, len);
 }
@@ -0,0 +1,62 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Per-register dirty tracking for PWM buffers, so a flush only transmits the
+// registers that changed since the last one, in auto-increment bursts.
+
+// Clean registers between two dirty ones are sent along with them when the
+// gap is at most this long, as that is cheaper than starting a new transfer.
+#ifndef IS31_PWM_DIRTY_GAP
+#    define IS31_PWM_DIRTY_GAP 2
+#endif
+
+#define IS31_PWM_DIRTY_SIZE(register_count) (((register_count) + 7) / 8)
+
+static inline void is31_pwm_dirty_mark(uint8_t *dirty, uint8_t reg) {
+    dirty[reg / 8] |= (1 << (reg % 8));
+}
+
+static inline bool is31_pwm_dirty_test(const uint8_t *dirty, uint8_t reg) {
+    return dirty[reg / 8] & (1 << (reg % 8));
+}
+
+/** \brief Find the next span of registers to transmit
+ *
+ * Starts searching at *start and on success stores the first register and the
+ * length of the span, which is never longer than max_length. Returns false
+ * when there are no dirty registers left.
+ */
+static inline bool is31_pwm_dirty_next_span(const uint8_t *dirty, uint8_t register_count, uint8_t max_length, uint8_t *start, uint8_t *length) {
+    uint8_t reg = *start;
+
+    while (reg < register_count && !is31_pwm_dirty_test(dirty, reg)) {
+        // skip over fully clean bytes of the bitmap
+        if (reg % 8 == 0 && dirty[reg / 8] == 0) {
+            reg += 8;
+        } else {
+            reg++;
+        }
+    }
+    if (reg >= register_count) {
+        return false;
+    }
+
+    uint8_t end = reg + 1;
+    for (uint8_t probe = end; probe < register_count && probe - reg < max_length; probe++) {
+        if (is31_pwm_dirty_test(dirty, probe)) {
+            end = probe + 1;
+        } else if (probe - end >= IS31_PWM_DIRTY_GAP) {
+            break;
+        }
+    }
+
+    *start  = reg;
+    *length = end - reg;
+    return true;
+}
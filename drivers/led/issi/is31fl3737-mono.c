@@ -20,6 +20,7 @@
 #include "is31fl3737-mono.h"
 #include "i2c_master.h"
 #include "gpio.h"
+#include "is31_pwm_dirty.h"
 #include "wait.h"
 
 #define IS31FL3737_PWM_REGISTER_COUNT 192 // actually 144
@@ -68,9 +69,12 @@ const uint8_t i2c_addresses[IS31FL3737_DRIVER_COUNT] = {
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in is31fl3737_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
+// The dirty bitmap has one bit per PWM register, so that only the changed
+// registers are transmitted.
 typedef struct is31fl3737_driver_t {
     uint8_t pwm_buffer[IS31FL3737_PWM_REGISTER_COUNT];
     bool    pwm_buffer_dirty;
+    uint8_t pwm_dirty_registers[IS31_PWM_DIRTY_SIZE(IS31FL3737_PWM_REGISTER_COUNT)];
     uint8_t led_control_buffer[IS31FL3737_LED_CONTROL_REGISTER_COUNT];
     bool    led_control_buffer_dirty;
 } PACKED is31fl3737_driver_t;
@@ -78,6 +82,7 @@ typedef struct is31fl3737_driver_t {
 is31fl3737_driver_t driver_buffers[IS31FL3737_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
     .pwm_buffer_dirty         = false,
+    .pwm_dirty_registers      = {0},
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
@@ -97,20 +102,38 @@ void is31fl3737_select_page(uint8_t index, uint8_t page) {
     is31fl3737_write_register(index, IS31FL3737_REG_COMMAND, page);
 }
 
+#if defined(I2C_ASYNC_ENABLE) && IS31FL3737_I2C_PERSISTENCE == 0
+// Queues the page switch behind the PWM writes already submitted instead of waiting for them.
+static void is31fl3737_select_page_async(uint8_t index, uint8_t page) {
+    uint8_t magic = IS31FL3737_COMMAND_WRITE_LOCK_MAGIC;
+    i2c_write_register_async(i2c_addresses[index] << 1, IS31FL3737_REG_COMMAND_WRITE_LOCK, &magic, 1, IS31FL3737_I2C_TIMEOUT, NULL, NULL);
+    i2c_write_register_async(i2c_addresses[index] << 1, IS31FL3737_REG_COMMAND, &page, 1, IS31FL3737_I2C_TIMEOUT, NULL, NULL);
+}
+#else
+#    define is31fl3737_select_page_async is31fl3737_select_page
+#endif
+
 void is31fl3737_write_pwm_buffer(uint8_t index) {
     // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit the changed PWM registers in transfers of up to 16 bytes.
+    uint8_t *dirty = driver_buffers[index].pwm_dirty_registers;
+    uint8_t  start = 0;
+    uint8_t  length;
 
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3737_PWM_REGISTER_COUNT; i += 16) {
+    while (is31_pwm_dirty_next_span(dirty, IS31FL3737_PWM_REGISTER_COUNT, 16, &start, &length)) {
 #if IS31FL3737_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < IS31FL3737_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3737_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(i2c_addresses[index] << 1, start, driver_buffers[index].pwm_buffer + start, length, IS31FL3737_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
+#elif defined(I2C_ASYNC_ENABLE)
+        i2c_write_register_async(i2c_addresses[index] << 1, start, driver_buffers[index].pwm_buffer + start, length, IS31FL3737_I2C_TIMEOUT, NULL, NULL);
 #else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3737_I2C_TIMEOUT);
+        i2c_write_register(i2c_addresses[index] << 1, start, driver_buffers[index].pwm_buffer + start, length, IS31FL3737_I2C_TIMEOUT);
 #endif
+        start += length;
     }
+
+    memset(dirty, 0, IS31_PWM_DIRTY_SIZE(IS31FL3737_PWM_REGISTER_COUNT));
 }
 
 void is31fl3737_init_drivers(void) {
@@ -181,7 +204,8 @@ void is31fl3737_set_value(int index, uint8_t value) {
         }
 
         driver_buffers[led.driver].pwm_buffer[led.v] = value;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        is31_pwm_dirty_mark(driver_buffers[led.driver].pwm_dirty_registers, led.v);
+        driver_buffers[led.driver].pwm_buffer_dirty = true;
     }
 }
 
@@ -209,7 +233,7 @@ void is31fl3737_set_led_control_register(uint8_t index, bool value) {
 
 void is31fl3737_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        is31fl3737_select_page(index, IS31FL3737_COMMAND_PWM);
+        is31fl3737_select_page_async(index, IS31FL3737_COMMAND_PWM);
 
         is31fl3737_write_pwm_buffer(index);
 
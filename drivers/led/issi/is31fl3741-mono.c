@@ -107,8 +107,19 @@ void is31fl3741_select_page(uint8_t index, uint8_t page) {
     is31fl3741_write_register(index, IS31FL3741_REG_COMMAND, page);
 }
 
+#if defined(I2C_ASYNC_ENABLE) && IS31FL3741_I2C_PERSISTENCE == 0
+// Queues the page switch behind the PWM writes already submitted instead of waiting for them.
+static void is31fl3741_select_page_async(uint8_t index, uint8_t page) {
+    uint8_t magic = IS31FL3741_COMMAND_WRITE_LOCK_MAGIC;
+    i2c_write_register_async(i2c_addresses[index] << 1, IS31FL3741_REG_COMMAND_WRITE_LOCK, &magic, 1, IS31FL3741_I2C_TIMEOUT, NULL, NULL);
+    i2c_write_register_async(i2c_addresses[index] << 1, IS31FL3741_REG_COMMAND, &page, 1, IS31FL3741_I2C_TIMEOUT, NULL, NULL);
+}
+#else
+#    define is31fl3741_select_page_async is31fl3741_select_page
+#endif
+
 void is31fl3741_write_pwm_buffer(uint8_t index) {
-    is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_0);
+    is31fl3741_select_page_async(index, IS31FL3741_COMMAND_PWM_0);
 
     // Transmit PWM0 registers in 6 transfers of 30 bytes.
 
@@ -118,12 +129,14 @@ void is31fl3741_write_pwm_buffer(uint8_t index) {
         for (uint8_t j = 0; j < IS31FL3741_I2C_PERSISTENCE; j++) {
             if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
+#elif defined(I2C_ASYNC_ENABLE)
+        i2c_write_register_async(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT, NULL, NULL);
 #else
         i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT);
 #endif
     }
 
-    is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_1);
+    is31fl3741_select_page_async(index, IS31FL3741_COMMAND_PWM_1);
 
     // Transmit PWM1 registers in 9 transfers of 19 bytes.
 
@@ -133,6 +146,8 @@ void is31fl3741_write_pwm_buffer(uint8_t index) {
         for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
             if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
+#elif defined(I2C_ASYNC_ENABLE)
+        i2c_write_register_async(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT, NULL, NULL);
 #else
         i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT);
 #endif
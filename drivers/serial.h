@@ -28,6 +28,12 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// starts a transaction in the background, soft_serial_transaction_finish waits for its result
+void soft_serial_transaction_start(int sstd_index);
+bool soft_serial_transaction_finish(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -74,3 +74,10 @@
  *         - Wait 50us to reset the LEDs
  */
 void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds);
+
+#if defined(WS2812_SPI) && defined(WS2812_SPI_DOUBLE_BUFFER)
+// true while the previous frame is still being sent
+bool ws2812_busy(void);
+// called from the SPI interrupt once a frame has been sent
+void ws2812_frame_complete(void);
+#endif
@@ -47,6 +47,10 @@
    dimming factor:
      new_bright = scale8_video( orig_bright, dimming);
 
+   Four bytes packed into a 32-bit word can be scaled
+   at once, two lanes per multiply:
+     scale8_x4( packed, sc) == scale8() on each byte
+
 
  - Fast 8- and 16- bit unsigned random numbers.
    Significantly faster than Arduino random(), but
@@ -183,13 +187,32 @@ Lib8tion is pronounced like 'libation': lie-BAY-shun
 #define QADD7_C 0
 #define QADD8_ARM_DSP_ASM 1
 #define QADD7_ARM_DSP_ASM 1
+#elif defined(__ARM_FEATURE_SAT)
+// ARMv6 and ARMv7-M can saturate with USAT
+#define QADD8_C 0
+#define QADD7_C 1
+#define QADD8_ARM_SAT_ASM 1
 #else
 // Generic ARM
 #define QADD8_C 1
 #define QADD7_C 1
 #endif
 
+#if defined(__ARM_FEATURE_SAT)
+#define QSUB8_C 0
+#define QSUB8_ARM_SAT_ASM 1
+#else
 #define QSUB8_C 1
+#endif
+
+#if defined(__ARM_FEATURE_CLZ)
+// Count leading zeros is a single instruction
+#define SQRT16_CLZ 1
+#endif
+
+// 256 bytes of flash are cheap compared to the cycles spent in sin8_C
+#define SIN8_LUT 1
+
 #define SCALE8_C 1
 #define SCALE16BY8_C 1
 #define SCALE16_C 1
@@ -44,6 +44,10 @@ LIB8STATIC_ALWAYS_INLINE uint8_t qadd8( uint8_t i, uint8_t j)
 #elif QADD8_ARM_DSP_ASM == 1
     asm volatile( "uqadd8 %0, %0, %1" : "+r" (i) : "r" (j));
     return i;
+#elif QADD8_ARM_SAT_ASM == 1
+    uint32_t t = i + j;
+    asm( "usat %0, #8, %1" : "=r" (t) : "r" (t));
+    return t;
 #else
 #error "No implementation for qadd8 available."
 #endif
@@ -108,6 +112,10 @@ LIB8STATIC_ALWAYS_INLINE uint8_t qsub8( uint8_t i, uint8_t j)
          : "a"  (j) );
 
     return i;
+#elif QSUB8_ARM_SAT_ASM == 1
+    int32_t t = i - j;
+    asm( "usat %0, #8, %1" : "=r" (t) : "r" (t));
+    return t;
 #else
 #error "No implementation for qsub8 available."
 #endif
@@ -423,10 +431,16 @@ LIB8STATIC_ALWAYS_INLINE int8_t abs8( int8_t i)
 #endif
 }
 
+#if SQRT16_CLZ == 1
+#define sqrt16 sqrt16_clz
+#else
+#define sqrt16 sqrt16_C
+#endif
+
 ///         square root for 16-bit integers
 ///         About three times faster and five times smaller
 ///         than Arduino's general sqrt on AVR.
-LIB8STATIC uint8_t sqrt16(uint16_t x)
+LIB8STATIC uint8_t sqrt16_C(uint16_t x)
 {
     if( x <= 1) {
         return x;
@@ -456,6 +470,35 @@ LIB8STATIC uint8_t sqrt16(uint16_t x)
     return low - 1;
 }
 
+///         square root for 16-bit integers, one result bit
+///         per iteration. Counting the leading zeros of x
+///         skips the iterations that cannot produce a bit,
+///         so this is only a win where that is an instruction.
+///         Returns the same result as sqrt16_C for every x.
+LIB8STATIC uint8_t sqrt16_clz(uint16_t x)
+{
+    if( x <= 1) {
+        return x;
+    }
+
+    uint32_t op  = x;
+    uint32_t res = 0;
+    // highest power of four that is not larger than x
+    uint32_t one = 1UL << ((sizeof(unsigned int) * 8 - 1 - __builtin_clz(x)) & ~1);
+
+    while( one) {
+        if( op >= res + one) {
+            op -= res + one;
+            res = (res >> 1) + one;
+        } else {
+            res >>= 1;
+        }
+        one >>= 2;
+    }
+
+    return res;
+}
+
 /// blend a variable proproportion(0-255) of one byte to another
 /// @param a - the starting byte value
 /// @param b - the byte value to blend toward
@@ -0,0 +1,37 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "lib/lib8tion/lib8tion.h"
+}
+
+// The platform specific paths have to match the portable C implementations
+// bit for bit, as effects are tuned against the latter.
+
+TEST(Lib8tion, Sqrt16ClzMatchesBinarySearch) {
+    for (uint32_t x = 0; x <= UINT16_MAX; x++) {
+        ASSERT_EQ(sqrt16_clz(x), sqrt16_C(x)) << "x = " << x;
+    }
+}
+
+TEST(Lib8tion, Sin8LutMatchesApproximation) {
+    for (uint16_t theta = 0; theta <= UINT8_MAX; theta++) {
+        ASSERT_EQ(sin8_lut(theta), sin8_C(theta)) << "theta = " << theta;
+    }
+}
+
+TEST(Lib8tion, Scale8x4MatchesScale8) {
+    for (uint16_t scale = 0; scale <= UINT8_MAX; scale++) {
+        for (uint16_t value = 0; value <= UINT8_MAX; value++) {
+            uint8_t  lanes[4] = {(uint8_t)value, (uint8_t)(255 - value), (uint8_t)(value ^ 0x5A), (uint8_t)(value * 7)};
+            uint32_t packed   = lanes[0] | (uint32_t)lanes[1] << 8 | (uint32_t)lanes[2] << 16 | (uint32_t)lanes[3] << 24;
+            uint32_t scaled   = scale8_x4(packed, scale);
+
+            for (uint8_t lane = 0; lane < 4; lane++) {
+                ASSERT_EQ((uint8_t)(scaled >> (lane * 8)), scale8(lanes[lane], scale)) << "value = " << value << ", scale = " << scale << ", lane = " << (int)lane;
+            }
+        }
+    }
+}
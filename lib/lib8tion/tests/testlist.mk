@@ -0,0 +1 @@
+TEST_LIST += lib8tion
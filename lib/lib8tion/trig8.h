@@ -142,6 +142,8 @@ LIB8STATIC int16_t cos16( uint16_t theta)
 
 #if defined(__AVR__) && !defined(LIB8_ATTINY)
 #define sin8 sin8_avr
+#elif SIN8_LUT == 1
+#define sin8 sin8_lut
 #else
 #define sin8 sin8_C
 #endif
@@ -243,6 +245,20 @@ LIB8STATIC uint8_t sin8_C( uint8_t theta)
     return y;
 }
 
+#if SIN8_LUT == 1
+/// sin8_C for every input angle, for targets with flash to spare
+extern const uint8_t sin8_table[256];
+
+/// Table lookup version of sin8_C, returning exactly the same values.
+///
+/// @param theta input angle from 0-255
+/// @returns sin of theta, value between 0 and 255
+LIB8STATIC uint8_t sin8_lut( uint8_t theta)
+{
+    return sin8_table[theta];
+}
+#endif
+
 /// Fast 8-bit approximation of cos(x). This approximation never varies more than
 /// 2% from the floating point value you'd get by doing
 ///
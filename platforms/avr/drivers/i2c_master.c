@@ -26,6 +26,10 @@
 #include "util.h"
 #include "progmem.h"
 
+#ifdef I2C_ASYNC_ENABLE
+#    error "I2C_ASYNC_ENABLE is only supported on ChibiOS"
+#endif
+
 #ifndef F_SCL
 #    define F_SCL 400000UL // SCL frequency
 #endif
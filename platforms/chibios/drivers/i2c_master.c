@@ -129,6 +129,139 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 16
+#    endif
+#    ifndef I2C_ASYNC_MAX_LENGTH
+#        define I2C_ASYNC_MAX_LENGTH 32
+#    endif
+
+typedef struct i2c_async_request_t {
+    uint8_t              address;
+    uint16_t             length;
+    uint16_t             timeout;
+    i2c_async_callback_t callback;
+    void*                context;
+    uint8_t              packet[I2C_ASYNC_MAX_LENGTH + 1];
+} i2c_async_request_t;
+
+static i2c_async_request_t i2c_async_queue[I2C_ASYNC_QUEUE_SIZE];
+static uint8_t             i2c_async_head        = 0; // written by the submitting thread only
+static uint8_t             i2c_async_tail        = 0; // written by the I2C thread only
+static volatile uint8_t    i2c_async_outstanding = 0;
+static thread_reference_t  i2c_async_waiter      = NULL;
+static SEMAPHORE_DECL(i2c_async_free, I2C_ASYNC_QUEUE_SIZE);
+static SEMAPHORE_DECL(i2c_async_pending, 0);
+
+static THD_WORKING_AREA(waI2CAsyncThread, 256);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_async_pending);
+
+        i2c_async_request_t* request = &i2c_async_queue[i2c_async_tail];
+
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t        msg    = i2cMasterTransmitTimeout(&I2C_DRIVER, (request->address >> 1), request->packet, request->length, 0, 0, TIME_MS2I(request->timeout));
+        i2c_status_t status = i2c_epilogue(msg);
+
+        if (request->callback) {
+            request->callback(status, request->context);
+        }
+
+        i2c_async_tail = (i2c_async_tail + 1) % I2C_ASYNC_QUEUE_SIZE;
+        chSemSignal(&i2c_async_free);
+
+        chSysLock();
+        if (--i2c_async_outstanding == 0) {
+            chThdResumeS(&i2c_async_waiter, MSG_OK);
+        }
+        chSysUnlock();
+    }
+}
+
+static void i2c_async_start(void) {
+    static bool is_started = false;
+    if (!is_started) {
+        is_started = true;
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    }
+}
+
+// Only one thread may wait at a time: there is a single waiter reference, and
+// ChibiOS asserts if a second thread suspends on it. In practice that thread is
+// the main loop, the only thread making I2C calls.
+void i2c_async_wait(void) {
+    chSysLock();
+    if (i2c_async_outstanding > 0) {
+        chThdSuspendS(&i2c_async_waiter);
+    }
+    chSysUnlock();
+}
+
+bool i2c_async_busy(void) {
+    return i2c_async_outstanding > 0;
+}
+
+static i2c_status_t i2c_async_submit(uint8_t address, const uint8_t* header, uint8_t header_length, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    if (header_length + length > sizeof(i2c_async_queue[0].packet)) {
+        // Too large to queue, send it once everything queued before it has gone out.
+        uint8_t packet[header_length + length];
+        if (header_length > 0) {
+            memcpy(packet, header, header_length);
+        }
+        memcpy(packet + header_length, data, length);
+
+        i2c_async_wait();
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t        msg    = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), packet, header_length + length, 0, 0, TIME_MS2I(timeout));
+        i2c_status_t status = i2c_epilogue(msg);
+        if (callback) {
+            callback(status, context);
+        }
+        return status;
+    }
+
+    i2c_async_start();
+
+    // Blocks only while the queue is full.
+    chSemWait(&i2c_async_free);
+
+    i2c_async_request_t* request = &i2c_async_queue[i2c_async_head];
+    request->address             = address;
+    request->length              = header_length + length;
+    request->timeout             = timeout;
+    request->callback            = callback;
+    request->context             = context;
+    if (header_length > 0) {
+        memcpy(request->packet, header, header_length);
+    }
+    memcpy(request->packet + header_length, data, length);
+    i2c_async_head = (i2c_async_head + 1) % I2C_ASYNC_QUEUE_SIZE;
+
+    chSysLock();
+    i2c_async_outstanding++;
+    chSemSignalI(&i2c_async_pending);
+    chSchRescheduleS();
+    chSysUnlock();
+
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    return i2c_async_submit(address, NULL, 0, data, length, timeout, callback, context);
+}
+
+i2c_status_t i2c_write_register_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    return i2c_async_submit(devaddr, &regaddr, 1, data, length, timeout, callback, context);
+}
+#else
+#    define i2c_async_wait()
+#endif // I2C_ASYNC_ENABLE
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -150,18 +283,21 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 1];
@@ -175,6 +311,7 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 2];
@@ -189,12 +326,14 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_wait();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
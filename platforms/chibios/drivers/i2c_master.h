@@ -25,6 +25,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // ### DEPRECATED - DO NOT USE ###
 #define i2c_writeReg(devaddr, regaddr, data, length, timeout) i2c_write_register(devaddr, regaddr, data, length, timeout)
@@ -47,3 +48,16 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
+
+#ifdef I2C_ASYNC_ENABLE
+typedef void (*i2c_async_callback_t)(i2c_status_t status, void* context);
+
+// Queue a write to be sent in the background, in submission order. The data is copied, and the
+// callback (if any) runs on the I2C thread once the transfer has finished, so it must not make
+// I2C calls itself. Synchronous calls wait for the queue to drain first. Only one thread may
+// submit writes or wait on the queue, normally the main loop.
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context);
+i2c_status_t i2c_write_register_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context);
+void         i2c_async_wait(void);
+bool         i2c_async_busy(void);
+#endif
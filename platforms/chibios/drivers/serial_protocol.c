@@ -38,11 +38,52 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+static BSEMAPHORE_DECL(async_start, true);
+static BSEMAPHORE_DECL(async_done, true);
+static volatile uint8_t async_transaction_id = 0;
+static volatile bool    async_result         = false;
+static bool             async_in_flight      = false;
+
+/**
+ * @brief This thread runs on the master and executes transactions started by
+ * soft_serial_transaction_start, so that the main loop can carry on while the
+ * bytes are on the wire.
+ */
+static THD_WORKING_AREA(waMasterThread, 1024);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&async_start);
+        serial_transport_driver_clear();
+        async_result = initiate_transaction(async_transaction_id);
+        chBSemSignal(&async_done);
+    }
+}
+
+/**
+ * @brief Waits for the in-flight asynchronous transaction, if any, to finish.
+ */
+static inline void async_transaction_wait(void) {
+    if (async_in_flight) {
+        chBSemWait(&async_done);
+        async_in_flight = false;
+    }
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Start async transaction thread. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
+#endif // SPLIT_TRANSPORT_ASYNC
 }
 
 /**
@@ -100,6 +141,11 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* The line is busy until the background transaction is done. */
+    async_transaction_wait();
+#endif // SPLIT_TRANSPORT_ASYNC
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
@@ -107,6 +153,32 @@ bool soft_serial_transaction(int index) {
     return initiate_transaction((uint8_t)index);
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for it to complete.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ */
+void soft_serial_transaction_start(int index) {
+    async_transaction_wait();
+
+    async_transaction_id = (uint8_t)index;
+    async_in_flight      = true;
+    chBSemSignal(&async_start);
+}
+
+/**
+ * @brief Wait for the transaction started by soft_serial_transaction_start.
+ *
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction_finish(void) {
+    async_transaction_wait();
+    return async_result;
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Initiate transaction to slave half.
  */
@@ -85,58 +85,90 @@
 #define DATA_SIZE (BYTES_FOR_LED * WS2812_LED_COUNT)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// Encode the next frame into a back buffer while the previous one is still being sent
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+#    if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+#        error "WS2812_SPI_DOUBLE_BUFFER cannot be combined with WS2812_SPI_USE_CIRCULAR_BUFFER or WS2812_SPI_SYNC"
+#    endif
+#    define TXBUF_COUNT 2
+#else
+#    define TXBUF_COUNT 1
+#endif
+
+static uint8_t txbuf[TXBUF_COUNT][TXBUF_SIZE] = {0};
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static uint8_t       txbuf_back    = 0;
+static volatile bool txbuf_sending = false;
+#else
+#    define txbuf_back 0
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, each SPI byte carries two bits of LED data. This
+ * table holds the two SPI bytes for every nibble of LED data.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#define WS2812_SPI_SYMBOL(bits) ((((bits)&2) ? 0b11100000 : 0b10000000) | (((bits)&1) ? 0b1110 : 0b1000))
+#define WS2812_SPI_NIBBLE(n) \
+    { WS2812_SPI_SYMBOL((n) >> 2), WS2812_SPI_SYMBOL((n)&3) }
+
+static const uint8_t ws2812_spi_nibbles[16][2] = {
+    WS2812_SPI_NIBBLE(0),  WS2812_SPI_NIBBLE(1),  WS2812_SPI_NIBBLE(2),  WS2812_SPI_NIBBLE(3),  //
+    WS2812_SPI_NIBBLE(4),  WS2812_SPI_NIBBLE(5),  WS2812_SPI_NIBBLE(6),  WS2812_SPI_NIBBLE(7),  //
+    WS2812_SPI_NIBBLE(8),  WS2812_SPI_NIBBLE(9),  WS2812_SPI_NIBBLE(10), WS2812_SPI_NIBBLE(11), //
+    WS2812_SPI_NIBBLE(12), WS2812_SPI_NIBBLE(13), WS2812_SPI_NIBBLE(14), WS2812_SPI_NIBBLE(15), //
+};
+
+static inline uint8_t* set_led_byte(uint8_t* tx, uint8_t data) {
+    const uint8_t* high = ws2812_spi_nibbles[data >> 4];
+    const uint8_t* low  = ws2812_spi_nibbles[data & 0x0F];
+
+    tx[0] = high[0];
+    tx[1] = high[1];
+    tx[2] = low[0];
+    tx[3] = low[1];
+    return tx + BYTES_FOR_LED_BYTE;
 }
 
-static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_led_color_rgb(uint8_t* buf, rgb_led_t color, int pos) {
+    uint8_t* tx = &buf[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    tx = set_led_byte(tx, color.g);
+    tx = set_led_byte(tx, color.r);
+    tx = set_led_byte(tx, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    tx = set_led_byte(tx, color.r);
+    tx = set_led_byte(tx, color.g);
+    tx = set_led_byte(tx, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    tx = set_led_byte(tx, color.b);
+    tx = set_led_byte(tx, color.g);
+    tx = set_led_byte(tx, color.r);
 #endif
 #ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+    tx = set_led_byte(tx, color.w);
 #endif
+    (void)tx;
 }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+__attribute__((weak)) void ws2812_frame_complete(void) {}
+
+static void ws2812_spi_complete_cb(SPIDriver* spip) {
+    (void)spip;
+    txbuf_sending = false;
+    ws2812_frame_complete();
+}
+
+bool ws2812_busy(void) {
+    return txbuf_sending;
+}
+#endif
+
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -151,7 +183,11 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
+#    ifdef WS2812_SPI_DOUBLE_BUFFER
+        ws2812_spi_complete_cb, // end_cb
+#    else
         NULL, // end_cb
+#    endif
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,7 +206,11 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
+#    ifdef WS2812_SPI_DOUBLE_BUFFER
+        ws2812_spi_complete_cb, // data_cb
+#    else
         NULL, // data_cb
+#    endif
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -183,7 +223,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf[0]);
 #endif
 }
 
@@ -195,16 +235,23 @@ void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
     }
 
     for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
+        set_led_color_rgb(txbuf[txbuf_back], ledarray[i], i);
     }
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
-#    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+#    if defined(WS2812_SPI_SYNC)
+    spiSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf[0]);
+#    elif defined(WS2812_SPI_DOUBLE_BUFFER)
+    // The frame was encoded while the previous one was on the wire, only wait if it still is.
+    while (txbuf_sending) {
+    }
+    txbuf_sending = true;
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf[txbuf_back]);
+    txbuf_back ^= 1;
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf[0]);
 #    endif
 #endif
 }
@@ -0,0 +1,91 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom.h"
+}
+
+// Built with EEPROM_UPDATE_BLOCK_CHUNK_SIZE=8 and EEPROM_UPDATE_BLOCK_GAP=2
+static std::array<uint8_t, 64>                mock_eeprom;
+static std::vector<std::pair<size_t, size_t>> mock_writes; // offset and length of every block write
+static std::vector<std::pair<size_t, size_t>> mock_reads;  // offset and length of every block read
+
+extern "C" void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    mock_reads.emplace_back((uintptr_t)addr, len);
+    memcpy(buf, &mock_eeprom[(uintptr_t)addr], len);
+}
+
+extern "C" void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    mock_writes.emplace_back((uintptr_t)addr, len);
+    memcpy(&mock_eeprom[(uintptr_t)addr], buf, len);
+}
+
+class EepromUpdateBlock : public ::testing::Test {
+   protected:
+    std::array<uint8_t, 64> data;
+
+    void SetUp() override {
+        std::iota(mock_eeprom.begin(), mock_eeprom.end(), 0);
+        data = mock_eeprom;
+        mock_writes.clear();
+        mock_reads.clear();
+    }
+
+    void update(size_t offset, size_t length) {
+        eeprom_update_block(&data[offset], (void *)offset, length);
+        EXPECT_EQ(mock_eeprom, data) << "Contents differ after the update";
+    }
+};
+
+TEST_F(EepromUpdateBlock, UnchangedDataIsNotWritten) {
+    update(0, data.size());
+    EXPECT_TRUE(mock_writes.empty());
+    EXPECT_EQ(mock_reads.size(), data.size() / 8) << "Contents should be compared a chunk at a time";
+}
+
+TEST_F(EepromUpdateBlock, RunSplitAcrossChunksIsOneWrite) {
+    for (size_t i = 6; i < 11; i++) {
+        data[i] ^= 0xFF;
+    }
+    update(0, 32);
+    ASSERT_EQ(mock_writes.size(), 1);
+    EXPECT_EQ(mock_writes[0], std::make_pair((size_t)6, (size_t)5));
+}
+
+TEST_F(EepromUpdateBlock, RunsWithinGapAreMerged) {
+    data[3] ^= 0xFF;
+    data[6] ^= 0xFF;  // two unchanged bytes after the first run
+    data[14] ^= 0xFF; // and two more across the chunk boundary
+    data[17] ^= 0xFF;
+    update(0, 32);
+    ASSERT_EQ(mock_writes.size(), 2);
+    EXPECT_EQ(mock_writes[0], std::make_pair((size_t)3, (size_t)4));
+    EXPECT_EQ(mock_writes[1], std::make_pair((size_t)14, (size_t)4));
+}
+
+TEST_F(EepromUpdateBlock, RunsBeyondGapStaySeparate) {
+    data[3] ^= 0xFF;
+    data[7] ^= 0xFF; // three unchanged bytes in between
+    data[20] ^= 0xFF;
+    update(0, 32);
+    ASSERT_EQ(mock_writes.size(), 3);
+    EXPECT_EQ(mock_writes[0], std::make_pair((size_t)3, (size_t)1));
+    EXPECT_EQ(mock_writes[1], std::make_pair((size_t)7, (size_t)1));
+    EXPECT_EQ(mock_writes[2], std::make_pair((size_t)20, (size_t)1));
+}
+
+TEST_F(EepromUpdateBlock, UnalignedBlockWritesOnlyInsideIt) {
+    data[5] ^= 0xFF;
+    data[12] ^= 0xFF;
+    update(5, 11);
+    ASSERT_EQ(mock_writes.size(), 2);
+    EXPECT_EQ(mock_writes[0], std::make_pair((size_t)5, (size_t)1));
+    EXPECT_EQ(mock_writes[1], std::make_pair((size_t)12, (size_t)1));
+    EXPECT_EQ(mock_reads.size(), 2) << "Contents should be compared a chunk at a time";
+}
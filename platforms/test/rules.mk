@@ -23,3 +23,11 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+eeprom_update_block_DEFS := -DEEPROM_TEST_HARNESS -DNO_PRINT \
+	-DEEPROM_UPDATE_BLOCK_CHUNK_SIZE=8 \
+	-DEEPROM_UPDATE_BLOCK_GAP=2
+
+eeprom_update_block_SRC := \
+	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_update_block_tests.cpp
@@ -272,17 +272,24 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_begin(record->event.stamp);
+#endif
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && keymap_config.oneshot_enable) {
             clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
         }
 #endif
-        return;
+    } else {
+        process_record_handler(record);
+        post_process_record_quantum(record);
     }
 
-    process_record_handler(record);
-    post_process_record_quantum(record);
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_end();
+#endif
 }
 
 void process_record_handler(keyrecord_t *record) {
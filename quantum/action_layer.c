@@ -1,11 +1,13 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
+#include "keymap_common.h"
 
 #ifdef VIAL_ENABLE
 #include "vial.h"
@@ -322,33 +324,116 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
     } else {
         layer = read_source_layers_cache(key);
     }
-    return action_for_key(layer, key);
+    return action_for_keycode(effective_keymap_get_keycode(layer, key));
 #else
     return layer_switch_get_action(key);
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Resolve layer
  *
- * Gets the layer based on key info
+ * Walks the active layers from the top down and returns the first one where
+ * the key is not transparent, along with the keycode found there.
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
+static uint8_t layer_switch_resolve_layer(keypos_t key, uint16_t *keycode) {
     layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
+            *keycode = keymap_key_to_keycode(i, key);
+            if (action_for_keycode(*keycode).code != ACTION_TRANSPARENT) {
                 return i;
             }
         }
     }
     /* fall back to layer 0 */
+    *keycode = keymap_key_to_keycode(0, key);
     return 0;
+}
+#endif
+
+#if !defined(NO_ACTION_LAYER) && defined(EFFECTIVE_KEYMAP_CACHE)
+/** \brief effective keymap cache
+ *
+ * Resolved keycode and source layer of every matrix position for the layer
+ * state in effective_keymap_state. Entries are filled in lazily on first
+ * lookup, and the whole table is dropped whenever the layer state changes.
+ */
+static layer_state_t effective_keymap_state = 0;
+static uint16_t      effective_keymap_keycodes[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       effective_keymap_layers[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       effective_keymap_resolved[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)] = {0};
+
+/** \brief Effective keymap invalidate
+ *
+ * Drops every resolved entry. Must be called whenever the keycodes returned by
+ * keymap_key_to_keycode() change for reasons other than a layer state change.
+ */
+void effective_keymap_invalidate(void) {
+    memset(effective_keymap_resolved, 0, sizeof(effective_keymap_resolved));
+}
+
+/** \brief Effective keymap lookup
+ *
+ * Returns true and fills in the resolved layer and keycode if the key can be
+ * served from the cache, resolving it first if needed.
+ */
+static bool effective_keymap_lookup(keypos_t key, uint8_t *layer, uint16_t *keycode) {
+#    ifdef VIAL_ENABLE
+    /* keymap_key_to_keycode() masks every key while unlocking */
+    if (vial_unlock_in_progress) return false;
+#    endif
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return false;
+
+    layer_state_t layers = layer_state | default_layer_state;
+    if (layers != effective_keymap_state) {
+        effective_keymap_invalidate();
+        effective_keymap_state = layers;
+    }
+
+    const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+    const uint16_t storage_idx  = entry_number / (CHAR_BIT);
+    const uint8_t  storage_bit  = entry_number % (CHAR_BIT);
+    if (!(effective_keymap_resolved[storage_idx] & (1U << storage_bit))) {
+        effective_keymap_layers[key.row][key.col] = layer_switch_resolve_layer(key, &effective_keymap_keycodes[key.row][key.col]);
+        effective_keymap_resolved[storage_idx] |= (1U << storage_bit);
+    }
+
+    *layer   = effective_keymap_layers[key.row][key.col];
+    *keycode = effective_keymap_keycodes[key.row][key.col];
+    return true;
+}
+
+/** \brief Effective keymap get keycode
+ *
+ * Returns the keycode of the key on the given layer, served from the cache
+ * when the key currently resolves to that layer.
+ */
+uint16_t effective_keymap_get_keycode(uint8_t layer, keypos_t key) {
+    uint8_t  cached_layer;
+    uint16_t keycode;
+    if (effective_keymap_lookup(key, &cached_layer, &keycode) && cached_layer == layer) {
+        return keycode;
+    }
+    return keymap_key_to_keycode(layer, key);
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    uint16_t keycode;
+#    ifdef EFFECTIVE_KEYMAP_CACHE
+    uint8_t layer;
+    if (effective_keymap_lookup(key, &layer, &keycode)) {
+        return layer;
+    }
+#    endif
+    return layer_switch_resolve_layer(key, &keycode);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -359,7 +444,8 @@ uint8_t layer_switch_get_layer(keypos_t key) {
  * Gets action code based on key position
  */
 action_t layer_switch_get_action(keypos_t key) {
-    return action_for_key(layer_switch_get_layer(key), key);
+    uint8_t layer = layer_switch_get_layer(key);
+    return action_for_keycode(effective_keymap_get_keycode(layer, key));
 }
 
 #ifndef NO_ACTION_LAYER
@@ -163,6 +163,15 @@ uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+/* resolved keymap cache */
+#if !defined(NO_ACTION_LAYER) && defined(EFFECTIVE_KEYMAP_CACHE)
+void     effective_keymap_invalidate(void);
+uint16_t effective_keymap_get_keycode(uint8_t layer, keypos_t key);
+#else
+#    define effective_keymap_invalidate()
+#    define effective_keymap_get_keycode(layer, key) keymap_key_to_keycode(layer, key)
+#endif
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
@@ -19,6 +19,42 @@
 #include "progmem.h"
 #include "util.h"
 
+static inline void hsv_region_to_rgb(RGB *rgb, uint8_t region, uint8_t v, uint8_t p, uint8_t q, uint8_t t) {
+    switch (region) {
+        case 6:
+        case 0:
+            rgb->r = v;
+            rgb->g = t;
+            rgb->b = p;
+            break;
+        case 1:
+            rgb->r = q;
+            rgb->g = v;
+            rgb->b = p;
+            break;
+        case 2:
+            rgb->r = p;
+            rgb->g = v;
+            rgb->b = t;
+            break;
+        case 3:
+            rgb->r = p;
+            rgb->g = q;
+            rgb->b = v;
+            break;
+        case 4:
+            rgb->r = t;
+            rgb->g = p;
+            rgb->b = v;
+            break;
+        default:
+            rgb->r = v;
+            rgb->g = p;
+            rgb->b = q;
+            break;
+    }
+}
+
 RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     RGB      rgb;
     uint8_t  region, remainder, p, q, t;
@@ -60,39 +96,7 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     q = (v * (255 - ((s * remainder) >> 8))) >> 8;
     t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
 
-    switch (region) {
-        case 6:
-        case 0:
-            rgb.r = v;
-            rgb.g = t;
-            rgb.b = p;
-            break;
-        case 1:
-            rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
-            break;
-        case 2:
-            rgb.r = p;
-            rgb.g = v;
-            rgb.b = t;
-            break;
-        case 3:
-            rgb.r = p;
-            rgb.g = q;
-            rgb.b = v;
-            break;
-        case 4:
-            rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
-            break;
-        default:
-            rgb.r = v;
-            rgb.g = p;
-            rgb.b = q;
-            break;
-    }
+    hsv_region_to_rgb(&rgb, region, v, p, q, t);
 
     return rgb;
 }
@@ -109,6 +113,99 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+#ifdef HSV_TO_RGB_LUT
+// hue -> (region << 8 | remainder), identical to the arithmetic in hsv_to_rgb_impl
+#    define HSV_HUE_REGION(h) ((h) * 6 / 255)
+#    define HSV_HUE_LUT_ENTRY(h) ((HSV_HUE_REGION(h) << 8) | (uint8_t)(((h) * 2 - HSV_HUE_REGION(h) * 85) * 3))
+#    define HSV_HUE_LUT_ROW(r) \
+        HSV_HUE_LUT_ENTRY((r) * 16 + 0), HSV_HUE_LUT_ENTRY((r) * 16 + 1), HSV_HUE_LUT_ENTRY((r) * 16 + 2), HSV_HUE_LUT_ENTRY((r) * 16 + 3), \
+        HSV_HUE_LUT_ENTRY((r) * 16 + 4), HSV_HUE_LUT_ENTRY((r) * 16 + 5), HSV_HUE_LUT_ENTRY((r) * 16 + 6), HSV_HUE_LUT_ENTRY((r) * 16 + 7), \
+        HSV_HUE_LUT_ENTRY((r) * 16 + 8), HSV_HUE_LUT_ENTRY((r) * 16 + 9), HSV_HUE_LUT_ENTRY((r) * 16 + 10), HSV_HUE_LUT_ENTRY((r) * 16 + 11), \
+        HSV_HUE_LUT_ENTRY((r) * 16 + 12), HSV_HUE_LUT_ENTRY((r) * 16 + 13), HSV_HUE_LUT_ENTRY((r) * 16 + 14), HSV_HUE_LUT_ENTRY((r) * 16 + 15)
+
+static const uint16_t PROGMEM hsv_hue_lut[256] = {
+    HSV_HUE_LUT_ROW(0),
+    HSV_HUE_LUT_ROW(1),
+    HSV_HUE_LUT_ROW(2),
+    HSV_HUE_LUT_ROW(3),
+    HSV_HUE_LUT_ROW(4),
+    HSV_HUE_LUT_ROW(5),
+    HSV_HUE_LUT_ROW(6),
+    HSV_HUE_LUT_ROW(7),
+    HSV_HUE_LUT_ROW(8),
+    HSV_HUE_LUT_ROW(9),
+    HSV_HUE_LUT_ROW(10),
+    HSV_HUE_LUT_ROW(11),
+    HSV_HUE_LUT_ROW(12),
+    HSV_HUE_LUT_ROW(13),
+    HSV_HUE_LUT_ROW(14),
+    HSV_HUE_LUT_ROW(15)
+};
+#endif
+
+/** \brief Converts an array of HSV values to RGB in one pass
+ *
+ * Produces exactly the same output as calling hsv_to_rgb_impl() on every
+ * element. Saturation and value dependent terms are only recomputed when they
+ * change between consecutive elements, which is the common case for effects
+ * that vary the hue or value across the matrix. With HSV_TO_RGB_LUT defined,
+ * the hue region and remainder are read from a 512 byte table instead.
+ */
+void hsv_to_rgb_batch_impl(const HSV *hsv, RGB *rgb, uint8_t count, bool use_cie) {
+    uint8_t  last_s = 0, last_v = 0;
+    uint16_t s = 0, v = 0;
+    uint8_t  p = 0;
+#ifdef USE_CIE1931_CURVE
+    v = use_cie ? pgm_read_byte(&CIE1931_CURVE[0]) : 0;
+#else
+    (void)use_cie;
+#endif
+    p = (v * 255) >> 8;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (hsv[i].s != last_s || hsv[i].v != last_v) {
+            last_s = hsv[i].s;
+            last_v = hsv[i].v;
+            s      = last_s;
+#ifdef USE_CIE1931_CURVE
+            v = use_cie ? pgm_read_byte(&CIE1931_CURVE[last_v]) : last_v;
+#else
+            v = last_v;
+#endif
+            p = (v * (255 - s)) >> 8;
+        }
+
+        if (s == 0) {
+            rgb[i].r = v;
+            rgb[i].g = v;
+            rgb[i].b = v;
+            continue;
+        }
+
+#ifdef HSV_TO_RGB_LUT
+        uint16_t entry     = pgm_read_word(&hsv_hue_lut[hsv[i].h]);
+        uint8_t  region    = entry >> 8;
+        uint8_t  remainder = entry & 0xFF;
+#else
+        uint16_t h         = hsv[i].h;
+        uint8_t  region    = h * 6 / 255;
+        uint8_t  remainder = (h * 2 - region * 85) * 3;
+#endif
+        uint8_t q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        uint8_t t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+        hsv_region_to_rgb(&rgb[i], region, v, p, q, t);
+    }
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led) {
     // Determine lowest value in all three colors, put that into
@@ -156,6 +156,17 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+bool deferred_exec_advanced_is_due(deferred_executor_t *table, size_t table_count, uint32_t within_ms) {
+    uint32_t now = timer_read32();
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= (int32_t)within_ms) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -175,3 +186,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_is_due(uint32_t within_ms) {
+    return deferred_exec_advanced_is_due(basic_executors, MAX_DEFERRED_EXECUTORS, within_ms);
+}
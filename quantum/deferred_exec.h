@@ -65,6 +65,14 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Checks whether any deferred execution is due to be invoked soon.
+ *
+ * @param within_ms[in] the number of milliseconds to look ahead
+ * @return true if any deferred execution will be invoked within the given number of milliseconds
+ */
+bool deferred_exec_is_due(uint32_t within_ms);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -119,3 +127,13 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Checks whether any deferred execution in a custom table is due to be invoked soon.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param within_ms[in] the number of milliseconds to look ahead
+ * @return true if any deferred execution will be invoked within the given number of milliseconds
+ */
+bool deferred_exec_advanced_is_due(deferred_executor_t *table, size_t table_count, uint32_t within_ms);
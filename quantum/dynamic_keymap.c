@@ -17,12 +17,15 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
 #include "action_tapping.h"
 #include "wait.h"
+#include "util.h"
+#include "qmk_settings.h"
 #include <string.h>
 
 #ifdef VIA_ENABLE
@@ -77,7 +80,6 @@
 #define VIAL_QMK_SETTINGS_EEPROM_ADDR (VIAL_ENCODERS_EEPROM_ADDR + VIAL_ENCODERS_SIZE)
 
 #ifdef QMK_SETTINGS
-#include "qmk_settings.h"
 #define VIAL_QMK_SETTINGS_SIZE (sizeof(qmk_settings_t))
 #else
 #define VIAL_QMK_SETTINGS_SIZE 0
@@ -132,6 +134,166 @@ _Static_assert(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR >= DYNAMIC_KEYMAP_MACRO_EEPROM_ADD
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+#    include "timer.h"
+
+// How many macro triggers may be waiting behind the one being played
+#    ifndef DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE
+#        define DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE 4
+#    endif
+
+static void dynamic_keymap_macro_stop(void);
+#endif
+
+// Start offset of each macro within the macro buffer, so a macro can be found
+// without walking the buffer. It is rebuilt on the first lookup after the
+// buffer has been written or reset.
+#define DYNAMIC_KEYMAP_MACRO_MISSING 0xFFFF
+static uint16_t dynamic_keymap_macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     dynamic_keymap_macro_offsets_valid = false;
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    include "deferred_exec.h"
+
+// How long the keymap must be left untouched before dirty blocks are written back
+#    ifndef DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY 100
+#    endif
+
+// Granularity of the dirty tracking, and the most that is written back per flush tick
+#    ifndef DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE
+#        define DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE 32
+#    endif
+
+// The mirror covers the keymaps and the encoder maps that follow them, in EEPROM layout
+#    define DYNAMIC_KEYMAP_MIRROR_SIZE ((DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2) + VIAL_ENCODERS_SIZE)
+#    define DYNAMIC_KEYMAP_MIRROR_BLOCKS ((DYNAMIC_KEYMAP_MIRROR_SIZE + DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE - 1) / DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE)
+
+static uint8_t dynamic_keymap_mirror[DYNAMIC_KEYMAP_MIRROR_SIZE];
+static uint8_t dynamic_keymap_mirror_dirty[(DYNAMIC_KEYMAP_MIRROR_BLOCKS + 7) / 8];
+static bool    dynamic_keymap_mirror_loaded = false;
+
+static deferred_executor_t dynamic_keymap_flush_executors[1] = {0};
+static uint32_t            dynamic_keymap_flush_last_exec    = 0;
+static deferred_token      dynamic_keymap_flush_token        = INVALID_DEFERRED_TOKEN;
+
+static void dynamic_keymap_mirror_load(void) {
+    if (!dynamic_keymap_mirror_loaded) {
+        eeprom_read_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_MIRROR_SIZE);
+        memset(dynamic_keymap_mirror_dirty, 0, sizeof(dynamic_keymap_mirror_dirty));
+        dynamic_keymap_mirror_loaded = true;
+    }
+}
+
+// Forgets the mirror so it is reloaded from EEPROM, dropping any pending write-back
+static void dynamic_keymap_mirror_invalidate(void) {
+    if (dynamic_keymap_flush_token != INVALID_DEFERRED_TOKEN) {
+        cancel_deferred_exec_advanced(dynamic_keymap_flush_executors, 1, dynamic_keymap_flush_token);
+        dynamic_keymap_flush_token = INVALID_DEFERRED_TOKEN;
+    }
+    dynamic_keymap_mirror_loaded = false;
+}
+
+// Writes back the first dirty block, returns false if there was nothing left to write
+static bool dynamic_keymap_mirror_flush_block(void) {
+    for (uint16_t block = 0; block < DYNAMIC_KEYMAP_MIRROR_BLOCKS; block++) {
+        if (dynamic_keymap_mirror_dirty[block / 8] & (1 << (block % 8))) {
+            uint16_t offset = block * DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE;
+            uint16_t size   = MIN(DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE, DYNAMIC_KEYMAP_MIRROR_SIZE - offset);
+            eeprom_update_block(&dynamic_keymap_mirror[offset], (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), size);
+            dynamic_keymap_mirror_dirty[block / 8] &= ~(1 << (block % 8));
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t dynamic_keymap_flush_callback(uint32_t trigger_time, void *cb_arg) {
+    if (dynamic_keymap_mirror_flush_block()) {
+        // Come back on the next tick for the remaining blocks, so a bulk write
+        // never holds up the main loop for more than one block
+        return 1;
+    }
+    dynamic_keymap_flush_token = INVALID_DEFERRED_TOKEN;
+    return 0;
+}
+
+static uint8_t dynamic_keymap_read_byte(void *address) {
+    uint16_t offset = (uint16_t)((uintptr_t)address - DYNAMIC_KEYMAP_EEPROM_ADDR);
+    if ((uintptr_t)address < DYNAMIC_KEYMAP_EEPROM_ADDR || offset >= DYNAMIC_KEYMAP_MIRROR_SIZE) {
+        return eeprom_read_byte(address);
+    }
+    dynamic_keymap_mirror_load();
+    return dynamic_keymap_mirror[offset];
+}
+
+static void dynamic_keymap_update_byte(void *address, uint8_t value) {
+    uint16_t offset = (uint16_t)((uintptr_t)address - DYNAMIC_KEYMAP_EEPROM_ADDR);
+    if ((uintptr_t)address < DYNAMIC_KEYMAP_EEPROM_ADDR || offset >= DYNAMIC_KEYMAP_MIRROR_SIZE) {
+        eeprom_update_byte(address, value);
+        return;
+    }
+    dynamic_keymap_mirror_load();
+    if (dynamic_keymap_mirror[offset] == value) {
+        return;
+    }
+    dynamic_keymap_mirror[offset] = value;
+
+    uint16_t block = offset / DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE;
+    dynamic_keymap_mirror_dirty[block / 8] |= (1 << (block % 8));
+
+    // Coalesce bursts of writes: the flush only starts once writes have settled
+    if (dynamic_keymap_flush_token == INVALID_DEFERRED_TOKEN || !extend_deferred_exec_advanced(dynamic_keymap_flush_executors, 1, dynamic_keymap_flush_token, DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY)) {
+        dynamic_keymap_flush_token = defer_exec_advanced(dynamic_keymap_flush_executors, 1, DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY, dynamic_keymap_flush_callback, NULL);
+    }
+}
+
+static void dynamic_keymap_read_block(uint8_t *data, void *address, uint16_t size) {
+    uintptr_t start = (uintptr_t)address;
+    uintptr_t end   = start + size;
+    uintptr_t first = MAX(start, DYNAMIC_KEYMAP_EEPROM_ADDR);
+    uintptr_t last  = MIN(end, DYNAMIC_KEYMAP_EEPROM_ADDR + DYNAMIC_KEYMAP_MIRROR_SIZE);
+    if (first >= last) {
+        eeprom_read_block(data, address, size);
+        return;
+    }
+    // Only the parts outside the mirror come from EEPROM, which is stale for dirty blocks that are yet to be flushed
+    if (start < first) {
+        eeprom_read_block(data, address, first - start);
+    }
+    if (last < end) {
+        eeprom_read_block(data + (last - start), (void *)last, end - last);
+    }
+    dynamic_keymap_mirror_load();
+    memcpy(data + (first - start), &dynamic_keymap_mirror[first - DYNAMIC_KEYMAP_EEPROM_ADDR], last - first);
+}
+
+// Writes into the mirror are RAM-only, so doing these a byte at a time is cheap
+static void dynamic_keymap_update_block(const uint8_t *data, void *address, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++) {
+        dynamic_keymap_update_byte((uint8_t *)address + i, data[i]);
+    }
+}
+
+void dynamic_keymap_init(void) {
+    dynamic_keymap_mirror_load();
+}
+
+void dynamic_keymap_flush(void) {
+    if (dynamic_keymap_flush_token != INVALID_DEFERRED_TOKEN) {
+        cancel_deferred_exec_advanced(dynamic_keymap_flush_executors, 1, dynamic_keymap_flush_token);
+        dynamic_keymap_flush_token = INVALID_DEFERRED_TOKEN;
+    }
+    while (dynamic_keymap_mirror_flush_block())
+        ;
+}
+#else
+#    define dynamic_keymap_read_byte(address) eeprom_read_byte(address)
+#    define dynamic_keymap_update_byte(address, value) eeprom_update_byte(address, value)
+#    define dynamic_keymap_read_block(data, address, size) eeprom_read_block(data, address, size)
+#    define dynamic_keymap_update_block(data, address, size) eeprom_update_block(data, address, size)
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -145,8 +307,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -154,8 +316,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    effective_keymap_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -167,8 +330,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -176,8 +339,8 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -272,6 +435,11 @@ void dynamic_keymap_reset(void) {
     vial_unlocked = 1;
 #endif
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The EEPROM may have just been erased underneath the mirror
+    dynamic_keymap_mirror_invalidate();
+#endif
+
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
@@ -320,23 +488,14 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid_size                 = offset < dynamic_keymap_eeprom_size ? MIN(size, dynamic_keymap_eeprom_size - offset) : 0;
+    dynamic_keymap_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), valid_size);
+    memset(data + valid_size, 0, size - valid_size);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
 
 #ifdef VIAL_ENABLE
     /* ensure the writes are bounded */
@@ -352,7 +511,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
         /* initial byte misaligned -- this means the first keycode will be a combination of existing and new data */
         if (offset % 2 != 0) {
-            uint16_t kc = (eeprom_read_byte((uint8_t*)target - 1) << 8) | data[0];
+            uint16_t kc = (dynamic_keymap_read_byte((uint8_t*)target - 1) << 8) | data[0];
             if (kc == QK_BOOT)
                 data[0] = 0xFF;
 
@@ -362,7 +521,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
         /* final byte misaligned -- this means the last keycode will be a combination of new and existing data */
         if ((offset + size) % 2 != 0) {
-            uint16_t kc = (data[size - 1] << 8) | eeprom_read_byte((uint8_t*)target + size);
+            uint16_t kc = (data[size - 1] << 8) | dynamic_keymap_read_byte((uint8_t*)target + size);
             if (kc == QK_BOOT)
                 data[size - 1] = 0xFF;
 
@@ -382,13 +541,9 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 #endif
 #endif
 
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid_size = offset < dynamic_keymap_eeprom_size ? MIN(size, dynamic_keymap_eeprom_size - offset) : 0;
+    dynamic_keymap_update_block(data, target, valid_size);
+    effective_keymap_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -416,135 +571,358 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid_size = offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) : 0;
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid_size);
+    memset(data + valid_size, 0, size - valid_size);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    dynamic_keymap_macro_offsets_valid = false;
+#ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+    dynamic_keymap_macro_stop();
+#endif
+    uint16_t valid_size = offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) : 0;
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid_size);
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (p != end) {
-        eeprom_update_byte(p, 0);
-        ++p;
+    dynamic_keymap_macro_offsets_valid = false;
+#ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+    dynamic_keymap_macro_stop();
+#endif
+    static const uint8_t zeros[32] = {0};
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(zeros)) {
+        eeprom_update_block(zeros, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), MIN(sizeof(zeros), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset));
     }
 }
 
+#ifdef VIAL_ENABLE
 static uint16_t decode_keycode(uint16_t kc) {
     /* map 0xFF01 => 0x0100; 0xFF02 => 0x0200, etc */
     if (kc > 0xFF00)
         return (kc & 0xFF) << 8;
     return kc;
 }
+#endif
 
-void dynamic_keymap_macro_send(uint8_t id) {
-    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
-        return;
+static void dynamic_keymap_macro_index(void) {
+    for (uint8_t id = 0; id < DYNAMIC_KEYMAP_MACRO_COUNT; id++) {
+        dynamic_keymap_macro_offsets[id] = DYNAMIC_KEYMAP_MACRO_MISSING;
     }
+    dynamic_keymap_macro_offsets_valid = true;
 
     // Check the last byte of the buffer.
     // If it's not zero, then we are in the middle
     // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    // write. So leave every macro missing.
+    if (eeprom_read_byte((void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1)) != 0) {
         return;
     }
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then the buffer
-        // contents are garbage, i.e. there were not DYNAMIC_KEYMAP_MACRO_COUNT
-        // nulls in the buffer.
-        if (p == end) {
-            return;
+    // Macro N starts after the Nth null. If there are fewer than
+    // DYNAMIC_KEYMAP_MACRO_COUNT nulls in the buffer, the rest stay missing.
+    uint8_t chunk[32];
+    uint8_t id                       = 0;
+    dynamic_keymap_macro_offsets[id] = 0;
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(chunk)) {
+        uint16_t size = MIN(sizeof(chunk), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset);
+        eeprom_read_block(chunk, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), size);
+        for (uint16_t i = 0; i < size; i++) {
+            if (chunk[i] != 0) {
+                continue;
+            }
+            if (++id == DYNAMIC_KEYMAP_MACRO_COUNT || offset + i + 1 == DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+                return;
+            }
+            dynamic_keymap_macro_offsets[id] = offset + i + 1;
+        }
+    }
+}
+
+// Locates the start of macro id, or returns NULL if there is no such macro
+// or the buffer is in the middle of being written.
+static void *dynamic_keymap_macro_find(uint8_t id) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
+        return NULL;
+    }
+    if (!dynamic_keymap_macro_offsets_valid) {
+        dynamic_keymap_macro_index();
+    }
+    if (dynamic_keymap_macro_offsets[id] == DYNAMIC_KEYMAP_MACRO_MISSING) {
+        return NULL;
+    }
+    return (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + dynamic_keymap_macro_offsets[id]);
+}
+
+// Position of a macro being played: the action it is on, and how many of that
+// action's key events have already been sent
+typedef struct {
+    uint8_t *pos;
+    uint8_t  event;
+} dynamic_keymap_macro_cursor_t;
+
+// A single key press or release within a macro action, and how long to wait after it
+typedef struct {
+    uint16_t keycode;
+    uint8_t  type;
+    uint16_t delay_ms;
+} dynamic_keymap_macro_event_t;
+
+enum {
+    DYNAMIC_KEYMAP_MACRO_EVENT_DOWN,
+    DYNAMIC_KEYMAP_MACRO_EVENT_UP,
+    DYNAMIC_KEYMAP_MACRO_EVENT_VIAL_DOWN,
+    DYNAMIC_KEYMAP_MACRO_EVENT_VIAL_UP,
+};
+
+// A plain character takes at most shift, AltGr, the key and a dead key space,
+// each pressed and released
+#define DYNAMIC_KEYMAP_MACRO_MAX_EVENTS 8
+
+#define DYNAMIC_KEYMAP_MACRO_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
+static uint8_t dynamic_keymap_macro_push(dynamic_keymap_macro_event_t *events, uint8_t count, uint8_t type, uint16_t keycode, uint16_t delay_ms) {
+    events[count] = (dynamic_keymap_macro_event_t){.keycode = keycode, .type = type, .delay_ms = delay_ms};
+    return count + 1;
+}
+
+// Breaks a plain character into the key events send_char_with_delay() would
+// produce, with the waits between them
+static uint8_t dynamic_keymap_macro_char_events(char ascii_code, dynamic_keymap_macro_event_t *events) {
+    const uint16_t interval   = DYNAMIC_KEYMAP_MACRO_DELAY;
+    uint8_t        keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool           is_shifted = DYNAMIC_KEYMAP_MACRO_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool           is_altgred = DYNAMIC_KEYMAP_MACRO_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool           is_dead    = DYNAMIC_KEYMAP_MACRO_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+    uint8_t        count      = 0;
+
+    if (is_shifted) count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_DOWN, KC_LEFT_SHIFT, interval);
+    if (is_altgred) count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_DOWN, KC_RIGHT_ALT, interval);
+    count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_DOWN, keycode, interval);
+    count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_UP, keycode, interval);
+    if (is_altgred) count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_UP, KC_RIGHT_ALT, interval);
+    if (is_shifted) count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_UP, KC_LEFT_SHIFT, interval);
+    if (is_dead) {
+        count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_DOWN, KC_SPACE, QS_tap_code_delay);
+        count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_UP, KC_SPACE, interval);
+    }
+    return count;
+}
+
+// Decodes the action at the start of window into key events. Sets *length to
+// the number of bytes the action takes and *delay_ms to any delay it asks
+// for. Returns -1 at the end of the macro.
+static int8_t dynamic_keymap_macro_decode(const uint8_t *window, dynamic_keymap_macro_event_t *events, uint8_t *length, uint16_t *delay_ms) {
+    *delay_ms = 0;
+
+    // Stop at the null terminator of this macro string
+    if (window[0] == 0) {
+        return -1;
+    }
+    if (window[0] != SS_QMK_PREFIX) {
+        *length = 1;
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        if (window[0] == '\a') {
+            // plays a song in the background rather than sending keys
+            send_char(window[0]);
+            return 0;
         }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
+#endif
+        return dynamic_keymap_macro_char_events(window[0], events);
+    }
+
+    // If the char is magic, process it as indicated by the next character
+    // (tap, down, up, delay)
+    if (window[1] == 0) return -1;
+    if (window[1] == SS_TAP_CODE || window[1] == SS_DOWN_CODE || window[1] == SS_UP_CODE) {
+        if (window[2] == 0) return -1;
+        // send_string() waits TAP_CODE_DELAY after each of these as well
+        uint8_t  keycode = window[2];
+        uint16_t hold    = keycode == KC_CAPS ? QS_tap_hold_caps_delay : QS_tap_code_delay;
+        uint8_t  count   = 0;
+        *length          = 3;
+        if (window[1] == SS_TAP_CODE) {
+            count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_DOWN, keycode, hold);
+            count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_UP, keycode, QS_tap_code_delay);
+        } else {
+            count = dynamic_keymap_macro_push(events, count, window[1] == SS_DOWN_CODE ? DYNAMIC_KEYMAP_MACRO_EVENT_DOWN : DYNAMIC_KEYMAP_MACRO_EVENT_UP, keycode, QS_tap_code_delay);
         }
-        ++p;
-    }
-
-    // Send the macro string one or three chars at a time
-    // by making temporary 1 or 3 char strings
-    char data[4] = {0, 0, 0, 0};
-    // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
-        // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
-            break;
+        return count;
+    }
+#ifdef VIAL_ENABLE
+    if (window[1] == VIAL_MACRO_EXT_TAP || window[1] == VIAL_MACRO_EXT_DOWN || window[1] == VIAL_MACRO_EXT_UP) {
+        if (window[2] == 0 || window[3] == 0) return -1;
+        uint16_t kc;
+        memcpy(&kc, &window[2], sizeof(kc));
+        kc           = decode_keycode(kc);
+        uint8_t count = 0;
+        *length       = 4;
+        if (window[1] != VIAL_MACRO_EXT_UP) {
+            count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_VIAL_DOWN, kc, window[1] == VIAL_MACRO_EXT_TAP ? QS_tap_code_delay : 0);
+        }
+        if (window[1] != VIAL_MACRO_EXT_DOWN) {
+            count = dynamic_keymap_macro_push(events, count, DYNAMIC_KEYMAP_MACRO_EVENT_VIAL_UP, kc, 0);
         }
-        if (data[0] == SS_QMK_PREFIX) {
-            // If the char is magic, process it as indicated by the next character
-            // (tap, down, up, delay)
-            data[1] = eeprom_read_byte(p++);
-            if (data[1] == 0)
+        return count;
+    }
+#endif
+    if (window[1] == SS_DELAY_CODE) {
+        // For delay, decode the delay and hand it back to the caller
+        uint8_t d0 = window[2];
+        uint8_t d1 = window[3];
+        if (d0 == 0 || d1 == 0) return -1;
+        // we cannot use 0 for these, need to subtract 1 and use 255 instead of 256 for delay calculation
+        *delay_ms = (d0 - 1) + (d1 - 1) * 255;
+        *length   = 4;
+        return 0;
+    }
+    *length = 2;
+    return 0;
+}
+
+// Performs the next key event of the action at cursor->pos, moving on to the
+// following action once all of its events are done. Nothing is waited out
+// here: the wait that should follow is returned in *delay_ms instead. Returns
+// false once the end of the macro has been reached.
+static bool dynamic_keymap_macro_step(dynamic_keymap_macro_cursor_t *cursor, uint16_t *delay_ms) {
+    // No action is longer than four bytes, so fetch them in one read. The
+    // buffer ends with a null, so a read cut short at its end is still
+    // terminated, and the rest of the window stays zero.
+    uint8_t  window[4] = {0, 0, 0, 0};
+    uint16_t remaining = (uint8_t *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) - cursor->pos;
+    eeprom_read_block(window, cursor->pos, MIN(sizeof(window), remaining));
+
+    dynamic_keymap_macro_event_t events[DYNAMIC_KEYMAP_MACRO_MAX_EVENTS];
+    uint8_t                      length = 0;
+    int8_t                       count  = dynamic_keymap_macro_decode(window, events, &length, delay_ms);
+    if (count < 0) {
+        return false;
+    }
+
+    if (cursor->event < count) {
+        dynamic_keymap_macro_event_t *event = &events[cursor->event++];
+        switch (event->type) {
+            case DYNAMIC_KEYMAP_MACRO_EVENT_DOWN:
+                register_code(event->keycode);
                 break;
-            if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
-                // For tap, down, up, just stuff it into the array and send_string it
-                data[2] = eeprom_read_byte(p++);
-                if (data[2] != 0)
-                    send_string(data);
-            } else if (data[1] == VIAL_MACRO_EXT_TAP || data[1] == VIAL_MACRO_EXT_DOWN || data[1] == VIAL_MACRO_EXT_UP) {
-                data[2] = eeprom_read_byte(p++);
-                if (data[2] != 0) {
-                    data[3] = eeprom_read_byte(p++);
-                    if (data[3] != 0) {
-                        uint16_t kc;
-                        memcpy(&kc, &data[2], sizeof(kc));
-                        kc = decode_keycode(kc);
-                        switch (data[1]) {
-                        case VIAL_MACRO_EXT_TAP:
-                            vial_keycode_tap(kc);
-                            break;
-                        case VIAL_MACRO_EXT_DOWN:
-                            vial_keycode_down(kc);
-                            break;
-                        case VIAL_MACRO_EXT_UP:
-                            vial_keycode_up(kc);
-                            break;
-                        }
-                    }
-                }
-            } else if (data[1] == SS_DELAY_CODE) {
-                // For delay, decode the delay and wait_ms for that amount
-                uint8_t d0 = eeprom_read_byte(p++);
-                uint8_t d1 = eeprom_read_byte(p++);
-                if (d0 == 0 || d1 == 0)
-                    break;
-                // we cannot use 0 for these, need to subtract 1 and use 255 instead of 256 for delay calculation
-                int ms = (d0 - 1) + (d1 - 1) * 255;
-                while (ms--) wait_ms(1);
-            }
-        } else {
-            // If the char wasn't magic, just send it
-            send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
+            case DYNAMIC_KEYMAP_MACRO_EVENT_UP:
+                unregister_code(event->keycode);
+                break;
+#ifdef VIAL_ENABLE
+            case DYNAMIC_KEYMAP_MACRO_EVENT_VIAL_DOWN:
+                vial_keycode_down(event->keycode);
+                break;
+            case DYNAMIC_KEYMAP_MACRO_EVENT_VIAL_UP:
+                vial_keycode_up(event->keycode);
+                break;
+#endif
         }
+        *delay_ms = event->delay_ms;
     }
+
+    if (cursor->event >= count) {
+        cursor->pos += length;
+        cursor->event = 0;
+    }
+    return true;
+}
+
+#ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+// Macros are played back from dynamic_keymap_task() one key press or release
+// per call, so scanning and the rest of the keyboard keep running while a
+// macro is sent. Delays, including TAP_CODE_DELAY and
+// DYNAMIC_KEYMAP_MACRO_DELAY, are waited out against the timer instead of
+// spinning in wait_ms().
+static uint8_t  dynamic_keymap_macro_queue[DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE];
+static uint8_t  dynamic_keymap_macro_queue_head  = 0;
+static uint8_t  dynamic_keymap_macro_queue_count = 0;
+static dynamic_keymap_macro_cursor_t dynamic_keymap_macro_cursor = {NULL, 0};
+static uint32_t dynamic_keymap_macro_resume_time = 0;
+
+// Abandons the macro being played and everything queued behind it, for when
+// the macro buffer is about to change underneath the player.
+static void dynamic_keymap_macro_stop(void) {
+    if (dynamic_keymap_macro_cursor.pos != NULL) {
+        // the macro may have been stopped between a key down and its key up
+        clear_keyboard();
+        dynamic_keymap_macro_cursor.pos = NULL;
+    }
+    dynamic_keymap_macro_queue_count = 0;
+}
+
+static void dynamic_keymap_macro_task(void) {
+    if (dynamic_keymap_macro_cursor.pos == NULL) {
+        if (dynamic_keymap_macro_queue_count == 0) {
+            return;
+        }
+        uint8_t id                      = dynamic_keymap_macro_queue[dynamic_keymap_macro_queue_head];
+        dynamic_keymap_macro_queue_head = (dynamic_keymap_macro_queue_head + 1) % DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE;
+        dynamic_keymap_macro_queue_count--;
+        dynamic_keymap_macro_cursor.pos   = dynamic_keymap_macro_find(id);
+        dynamic_keymap_macro_cursor.event = 0;
+        dynamic_keymap_macro_resume_time  = timer_read32();
+        return;
+    }
+
+    if (!timer_expired32(timer_read32(), dynamic_keymap_macro_resume_time)) {
+        return;
+    }
+
+    uint16_t delay_ms = 0;
+    if (!dynamic_keymap_macro_step(&dynamic_keymap_macro_cursor, &delay_ms)) {
+        dynamic_keymap_macro_cursor.pos = NULL;
+        return;
+    }
+    dynamic_keymap_macro_resume_time = timer_read32() + delay_ms;
+}
+
+void dynamic_keymap_macro_send(uint8_t id) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT || dynamic_keymap_macro_queue_count == DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE) {
+        return;
+    }
+    uint8_t tail                     = (dynamic_keymap_macro_queue_head + dynamic_keymap_macro_queue_count) % DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE;
+    dynamic_keymap_macro_queue[tail] = id;
+    dynamic_keymap_macro_queue_count++;
 }
+
+bool dynamic_keymap_macro_is_playing(void) {
+    return dynamic_keymap_macro_cursor.pos != NULL || dynamic_keymap_macro_queue_count > 0;
+}
+#else
+void dynamic_keymap_macro_send(uint8_t id) {
+    dynamic_keymap_macro_cursor_t cursor = {dynamic_keymap_macro_find(id), 0};
+    if (cursor.pos == NULL) {
+        return;
+    }
+
+    uint16_t delay_ms;
+    while (dynamic_keymap_macro_step(&cursor, &delay_ms)) {
+        while (delay_ms--) wait_ms(1);
+    }
+}
+#endif
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_MACRO_ASYNC)
+void dynamic_keymap_task(void) {
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    deferred_exec_advanced_task(dynamic_keymap_flush_executors, 1, &dynamic_keymap_flush_last_exec);
+#    endif
+#    ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+    dynamic_keymap_macro_task();
+#    endif
+}
+
+bool dynamic_keymap_task_is_due(uint32_t within_ms) {
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (deferred_exec_advanced_is_due(dynamic_keymap_flush_executors, 1, within_ms)) {
+        return true;
+    }
+#    endif
+#    ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+    if (dynamic_keymap_macro_is_playing()) {
+        return true;
+    }
+#    endif
+    return false;
+}
+#endif
@@ -66,6 +66,22 @@ void     dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// With DYNAMIC_KEYMAP_RAM_MIRROR = yes the keymaps and encoder maps are loaded
+// into RAM once and every lookup is served from there. Writes update RAM
+// immediately and are written back to EEPROM in the background, once they
+// have settled for DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY milliseconds.
+void dynamic_keymap_init(void);
+// Writes back any pending changes immediately
+void dynamic_keymap_flush(void);
+#endif
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_MACRO_ASYNC)
+void dynamic_keymap_task(void);
+// Returns true if dynamic_keymap_task() has work to do within the next within_ms milliseconds
+bool dynamic_keymap_task_is_due(uint32_t within_ms);
+#endif
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -96,3 +112,10 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+#ifdef DYNAMIC_KEYMAP_MACRO_ASYNC
+// With DYNAMIC_KEYMAP_MACRO_ASYNC defined, dynamic_keymap_macro_send() only
+// queues the macro, and dynamic_keymap_task() plays it back one key event at a
+// time. Returns true while a macro is being played or waiting in the queue.
+bool dynamic_keymap_macro_is_playing(void);
+#endif
@@ -32,6 +32,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "scan_profile.h"
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -104,6 +108,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -423,6 +430,9 @@ void keyboard_init(void) {
 #ifdef VIA_ENABLE
     via_init();
 #endif
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_init();
+#endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
 #endif
@@ -532,6 +542,26 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#ifdef MATRIX_SCAN_EVENT_DRIVEN
+/**
+ * @brief Checks whether the main loop has timed work coming up that sleeping
+ * on the matrix would hold back.
+ */
+static bool keyboard_work_is_due(void) {
+#    ifdef DEFERRED_EXEC_ENABLE
+    if (deferred_exec_is_due(MATRIX_SCAN_EVENT_TIMEOUT)) {
+        return true;
+    }
+#    endif
+#    if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_MACRO_ASYNC)
+    if (dynamic_keymap_task_is_due(MATRIX_SCAN_EVENT_TIMEOUT)) {
+        return true;
+    }
+#    endif
+    return false;
+}
+#endif
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -547,7 +577,15 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
+#ifdef MATRIX_SCAN_EVENT_DRIVEN
+    if (matrix_scan_is_idle() && !keyboard_work_is_due()) {
+        matrix_wait_for_event();
+    }
+#endif
+
+    SCAN_PROFILE_BEGIN(scan_start);
     matrix_scan();
+    SCAN_PROFILE_END(SCAN_PROFILE_MATRIX_SCAN, scan_start);
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
@@ -581,7 +619,9 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
+                    SCAN_PROFILE_BEGIN(exec_start);
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    SCAN_PROFILE_END(SCAN_PROFILE_ACTION_EXEC, exec_start);
                 }
 
                 switch_events(row, col, key_pressed);
@@ -672,12 +712,15 @@ void quantum_task(void) {
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
+    SCAN_PROFILE_BEGIN(task_start);
     if (matrix_task()) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
+    SCAN_PROFILE_BEGIN(quantum_start);
     quantum_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_QUANTUM_TASK, quantum_start);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
@@ -691,7 +734,9 @@ void keyboard_task(void) {
     led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
+    SCAN_PROFILE_BEGIN(rgb_matrix_start);
     rgb_matrix_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_RGB_MATRIX_TASK, rgb_matrix_start);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -760,4 +805,10 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#if defined(DYNAMIC_KEYMAP_RAM_MIRROR) || defined(DYNAMIC_KEYMAP_MACRO_ASYNC)
+    dynamic_keymap_task();
+#endif
+
+    SCAN_PROFILE_END(SCAN_PROFILE_KEYBOARD_TASK, task_start);
 }
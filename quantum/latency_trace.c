@@ -0,0 +1,155 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <string.h>
+#include "latency_trace.h"
+#include "timer.h"
+
+#ifdef PROTOCOL_CHIBIOS
+#    include <hal.h>
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t histogram[LATENCY_TRACE_BUCKETS];
+} latency_trace_stats_t;
+
+static latency_trace_stats_t latency_trace_stats[LATENCY_TRACE_STAGE_COUNT];
+
+static uint8_t           latency_trace_depth    = 0;
+static bool              latency_trace_pending  = false;
+static uint32_t          latency_trace_origin   = 0;
+static volatile uint32_t latency_trace_awaiting = 0;
+
+// Stamps are never zero, zero marks a record without one.
+#if defined(PROTOCOL_CHIBIOS) && (HAL_IMPLEMENTS_COUNTERS == TRUE)
+__attribute__((weak)) uint32_t latency_trace_now(void) {
+    return (uint32_t)halGetCounterValue() | 1;
+}
+
+static uint32_t latency_trace_to_us(uint32_t ticks) {
+    uint32_t frequency = (uint32_t)halGetCounterFrequency();
+    if (frequency >= 1000000) {
+        return ticks / (frequency / 1000000);
+    }
+    return (uint64_t)ticks * 1000000 / frequency;
+}
+#else
+// No free-running counter available, fall back to the millisecond timer.
+__attribute__((weak)) uint32_t latency_trace_now(void) {
+    return timer_read32() | 1;
+}
+
+static uint32_t latency_trace_to_us(uint32_t ticks) {
+    return ticks * 1000;
+}
+#endif
+
+static void latency_trace_record(latency_trace_stage_t stage, uint32_t start) {
+    latency_trace_stats_t *stats = &latency_trace_stats[stage];
+    uint32_t               us    = latency_trace_to_us(latency_trace_now() - start);
+    uint32_t               slot  = us / LATENCY_TRACE_BUCKET_US;
+
+    if (slot >= LATENCY_TRACE_BUCKETS) {
+        slot = LATENCY_TRACE_BUCKETS - 1;
+    }
+    if (stats->histogram[slot] == UINT16_MAX) {
+        // Halve every bucket rather than saturating, so the percentile stays meaningful on long runs.
+        for (uint8_t i = 0; i < LATENCY_TRACE_BUCKETS; i++) {
+            stats->histogram[i] /= 2;
+        }
+    }
+    stats->histogram[slot]++;
+    if (stats->count == 0 || us < stats->min) {
+        stats->min = us;
+    }
+    if (us > stats->max) {
+        stats->max = us;
+    }
+    stats->sum += us;
+    stats->count++;
+}
+
+void latency_trace_begin(uint32_t stamp) {
+    // Nested records are attributed to the outer event. Records built by hand without a stamp are not traced.
+    if (latency_trace_depth++ == 0) {
+        latency_trace_origin  = stamp;
+        latency_trace_pending = stamp != 0;
+    }
+}
+
+void latency_trace_end(void) {
+    if (latency_trace_depth > 0 && --latency_trace_depth == 0) {
+        latency_trace_pending = false;
+    }
+}
+
+void latency_trace_report_queued(bool await_completion) {
+    if (!latency_trace_pending) {
+        return;
+    }
+    latency_trace_pending = false;
+    latency_trace_record(LATENCY_TRACE_QUEUED, latency_trace_origin);
+
+    // Armed before the driver runs, so the transfer can be claimed however quickly it starts.
+    latency_trace_awaiting = await_completion ? latency_trace_origin : 0;
+}
+
+uint32_t latency_trace_report_started(void) {
+    uint32_t stamp         = latency_trace_awaiting;
+    latency_trace_awaiting = 0;
+    return stamp;
+}
+
+void latency_trace_report_dropped(void) {
+    latency_trace_awaiting = 0;
+}
+
+void latency_trace_report_completed(uint32_t stamp) {
+    if (stamp == 0) {
+        return;
+    }
+    latency_trace_record(LATENCY_TRACE_COMPLETED, stamp);
+}
+
+void latency_trace_get_summary(latency_trace_stage_t stage, latency_trace_summary_t *summary) {
+    memset(summary, 0, sizeof(latency_trace_summary_t));
+    if (stage >= LATENCY_TRACE_STAGE_COUNT) {
+        return;
+    }
+
+    const latency_trace_stats_t *stats = &latency_trace_stats[stage];
+    if (stats->count == 0) {
+        return;
+    }
+
+    summary->count = stats->count;
+    summary->min   = stats->min;
+    summary->max   = stats->max;
+    summary->avg   = stats->sum / stats->count;
+
+    // The 99th percentile is the upper edge of the bucket holding it, capped at the largest sample.
+    uint32_t total = 0;
+    for (uint8_t slot = 0; slot < LATENCY_TRACE_BUCKETS; slot++) {
+        total += stats->histogram[slot];
+    }
+    uint32_t target = total - total / 100;
+    uint32_t seen   = 0;
+    summary->p99    = stats->max;
+    for (uint8_t slot = 0; slot < LATENCY_TRACE_BUCKETS - 1; slot++) {
+        seen += stats->histogram[slot];
+        if (seen >= target) {
+            uint32_t edge = (uint32_t)(slot + 1) * LATENCY_TRACE_BUCKET_US - 1;
+            summary->p99  = edge < stats->max ? edge : stats->max;
+            break;
+        }
+    }
+}
+
+void latency_trace_reset(void) {
+    memset(latency_trace_stats, 0, sizeof(latency_trace_stats));
+}
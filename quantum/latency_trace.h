@@ -0,0 +1,77 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Key-to-report latency tracing.
+
+    Every key event is stamped when the matrix scan produces it. The stamp
+    travels with the event through the tapping and combo buffers. When that
+    event is finally processed, the first keyboard report it causes records
+    two samples: the time until the report was handed to the USB driver
+    (queued), and the time until the IN transfer completed (completed). The
+    completed sample is only taken on ChibiOS boards that have a dedicated
+    keyboard endpoint.
+
+    All durations are reported in microseconds.
+*/
+
+#ifndef LATENCY_TRACE_BUCKETS
+#    define LATENCY_TRACE_BUCKETS 64
+#endif
+
+#ifndef LATENCY_TRACE_BUCKET_US
+#    define LATENCY_TRACE_BUCKET_US 500
+#endif
+
+typedef enum {
+    LATENCY_TRACE_QUEUED,
+    LATENCY_TRACE_COMPLETED,
+    LATENCY_TRACE_STAGE_COUNT,
+} latency_trace_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t p99;
+    uint32_t max;
+} latency_trace_summary_t;
+
+/** \brief Returns the current value of the tracing counter, used to stamp key events */
+uint32_t latency_trace_now(void);
+
+/** \brief Marks the start of processing for an event stamped at `stamp`, zero means unstamped */
+void latency_trace_begin(uint32_t stamp);
+
+/** \brief Marks the end of processing for the event passed to latency_trace_begin() */
+void latency_trace_end(void);
+
+/** \brief Called just before a keyboard report is handed to the host driver
+ *
+ * `await_completion` should be true when the driver will claim the report with
+ * latency_trace_report_started() and report back through latency_trace_report_completed().
+ */
+void latency_trace_report_queued(bool await_completion);
+
+/** \brief Called by the driver, with interrupts locked, as it starts the transfer carrying the queued report
+ *
+ * Returns the stamp to pass to latency_trace_report_completed() once that transfer is done, zero if it is not traced.
+ */
+uint32_t latency_trace_report_started(void);
+
+/** \brief Called by the driver when the queued report is dropped instead of being sent */
+void latency_trace_report_dropped(void);
+
+/** \brief Called when the host has collected the report claimed with `stamp`, may be called from an ISR */
+void latency_trace_report_completed(uint32_t stamp);
+
+/** \brief Fills `summary` with the count, min, average, 99th percentile and max for `stage` */
+void latency_trace_get_summary(latency_trace_stage_t stage, latency_trace_summary_t *summary);
+
+/** \brief Clears all recorded samples */
+void latency_trace_reset(void);
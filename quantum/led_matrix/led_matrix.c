@@ -135,6 +135,22 @@ uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+// FNV-1a hash of every value written since the last flush. Writing the same
+// values to the same LEDs again leaves them unchanged, so a frame whose writes
+// hash the same as the previous frame's does not need to be flushed.
+static uint32_t led_frame_hash   = 2166136261UL;
+static uint32_t led_flushed_hash = 0;
+static bool     led_flush_forced = true;
+
+static void led_frame_hash_value(int index, uint8_t value) {
+    uint8_t data[] = {index & 0xFF, (index >> 8) & 0xFF, value};
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        led_frame_hash = (led_frame_hash ^ data[i]) * 16777619UL;
+    }
+}
+#endif
+
 void led_matrix_update_pwm_buffers(void) {
     led_matrix_driver.flush();
 }
@@ -142,6 +158,9 @@ void led_matrix_update_pwm_buffers(void) {
 void led_matrix_set_value(int index, uint8_t value) {
 #ifdef USE_CIE1931_CURVE
     value = pgm_read_byte(&CIE1931_CURVE[value]);
+#endif
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    led_frame_hash_value(index, value);
 #endif
     led_matrix_driver.set_value(index, value);
 }
@@ -152,10 +171,12 @@ void led_matrix_set_value_all(uint8_t value) {
         led_matrix_set_value(i, value);
 #else
 #    ifdef USE_CIE1931_CURVE
-    led_matrix_driver.set_value_all(pgm_read_byte(&CIE1931_CURVE[value]));
-#    else
-    led_matrix_driver.set_value_all(value);
+    value = pgm_read_byte(&CIE1931_CURVE[value]);
+#    endif
+#    ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    led_frame_hash_value(-1, value);
 #    endif
+    led_matrix_driver.set_value_all(value);
 #endif
 }
 
@@ -309,7 +330,17 @@ static void led_task_flush(uint8_t effect) {
     led_last_enable = led_matrix_eeconfig.enable;
 
     // update pwm buffers
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    bool changed     = led_flush_forced || led_frame_hash != led_flushed_hash;
+    led_flushed_hash = led_frame_hash;
+    led_frame_hash   = 2166136261UL;
+    led_flush_forced = false;
+    if (changed) {
+        led_matrix_update_pwm_buffers();
+    }
+#else
     led_matrix_update_pwm_buffers();
+#endif
 
     // next task
     led_task_state = SYNCING;
@@ -412,6 +443,9 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 
 void led_matrix_init(void) {
     led_matrix_driver.init();
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    led_flush_forced = true;
+#endif
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
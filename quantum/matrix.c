@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "matrix.h"
 #include "debounce.h"
+#include "scan_profile.h"
 #include "atomic_util.h"
 
 #ifdef SPLIT_KEYBOARD
@@ -270,6 +271,153 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_SCAN_EVENT_DRIVEN
+#    ifndef PROTOCOL_CHIBIOS
+#        error MATRIX_SCAN_EVENT_DRIVEN is only supported on ChibiOS targets.
+#    endif
+#    include <hal.h>
+#    if PAL_USE_CALLBACKS != TRUE
+#        error MATRIX_SCAN_EVENT_DRIVEN requires `#define PAL_USE_CALLBACKS TRUE` in halconf.h.
+#    endif
+#    include "debug.h"
+
+static thread_reference_t matrix_event_thread  = NULL;
+static bool               matrix_event_enabled = true;
+
+static void matrix_event_cb(void *arg) {
+    (void)arg;
+    osalSysLockFromISR();
+    osalThreadResumeI(&matrix_event_thread, MSG_OK);
+    osalSysUnlockFromISR();
+}
+
+#    if defined(DIRECT_PINS)
+#        define MATRIX_EVENT_INPUT_COUNT (ROWS_PER_HAND * MATRIX_COLS)
+#        define MATRIX_EVENT_INPUT(i) (direct_pins[(i) / MATRIX_COLS][(i) % MATRIX_COLS])
+#    elif (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_EVENT_INPUT_COUNT (MATRIX_COLS)
+#        define MATRIX_EVENT_INPUT(i) (col_pins[(i)])
+#    elif (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_EVENT_INPUT_COUNT (ROWS_PER_HAND)
+#        define MATRIX_EVENT_INPUT(i) (row_pins[(i)])
+#    endif
+
+static void matrix_event_select_all(void) {
+#    if defined(DIRECT_PINS)
+    // nothing to drive, every switch pulls its own pin
+#    elif (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+#    elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+#    endif
+}
+
+static void matrix_event_unselect_all(void) {
+#    if defined(DIRECT_PINS)
+    // nothing was driven
+#    elif (DIODE_DIRECTION == COL2ROW)
+    unselect_rows();
+#    elif (DIODE_DIRECTION == ROW2COL)
+    unselect_cols();
+#    endif
+}
+
+#    if defined(MCU_STM32)
+// Pin n of every port shares EXTI channel n, so two watched inputs with the
+// same pin number would take each other's interrupt
+static bool matrix_event_channels_unique(void) {
+    uint16_t channels = 0;
+    for (uint8_t i = 0; i < MATRIX_EVENT_INPUT_COUNT; i++) {
+        pin_t pin = MATRIX_EVENT_INPUT(i);
+        if (pin == NO_PIN) {
+            continue;
+        }
+        uint16_t channel = 1 << PAL_PAD(pin);
+        if (channels & channel) {
+            return false;
+        }
+        channels |= channel;
+    }
+#        if defined(SPLIT_KEYBOARD) && defined(SPLIT_EVENT_PIN)
+    if (is_keyboard_master() && (channels & (1 << PAL_PAD(SPLIT_EVENT_PIN)))) {
+        return false;
+    }
+#        endif
+    return true;
+}
+#    endif
+
+static void matrix_event_init(void) {
+#    if defined(MCU_STM32)
+    if (!matrix_event_channels_unique()) {
+        matrix_event_enabled = false;
+        dprintf("matrix: inputs share an EXTI channel, event driven scanning disabled\n");
+    }
+#    endif
+}
+
+/** \brief Sleep until any switch changes state
+ *
+ * Drives every output active so that any pressed switch pulls its input, arms a
+ * both-edges PAL event on every input and suspends the calling thread until an
+ * edge arrives or MATRIX_SCAN_EVENT_TIMEOUT milliseconds pass. Returns straight
+ * away if an input already reads as pressed. On a split master with
+ * SPLIT_EVENT_PIN, the slave's event line wakes it as well. Does nothing if the
+ * inputs cannot all be watched at once.
+ */
+void matrix_wait_for_event(void) {
+    if (!matrix_event_enabled) {
+        return;
+    }
+
+    matrix_event_select_all();
+    matrix_output_select_delay();
+
+    osalSysLock();
+    bool pressed = false;
+    for (uint8_t i = 0; i < MATRIX_EVENT_INPUT_COUNT; i++) {
+        pin_t pin = MATRIX_EVENT_INPUT(i);
+        if (pin == NO_PIN) {
+            continue;
+        }
+        palEnableLineEventI(pin, PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallbackI(pin, matrix_event_cb, NULL);
+        pressed |= readMatrixPin(pin) == 0;
+    }
+#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_EVENT_PIN)
+    // The slave pulls its event line low as soon as its half has something new
+    const bool split_event = is_keyboard_master();
+    if (split_event) {
+        palEnableLineEventI(SPLIT_EVENT_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+        palSetLineCallbackI(SPLIT_EVENT_PIN, matrix_event_cb, NULL);
+        pressed |= split_event_pending();
+    }
+#    endif
+    if (!pressed) {
+        osalThreadSuspendTimeoutS(&matrix_event_thread, TIME_MS2I(MATRIX_SCAN_EVENT_TIMEOUT));
+    }
+    for (uint8_t i = 0; i < MATRIX_EVENT_INPUT_COUNT; i++) {
+        pin_t pin = MATRIX_EVENT_INPUT(i);
+        if (pin != NO_PIN) {
+            palDisableLineEventI(pin);
+        }
+    }
+#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_EVENT_PIN)
+    if (split_event) {
+        palDisableLineEventI(SPLIT_EVENT_PIN);
+    }
+#    endif
+    osalSysUnlock();
+
+    matrix_event_unselect_all();
+    matrix_output_unselect_delay(0, true);
+}
+#endif // MATRIX_SCAN_EVENT_DRIVEN
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -309,6 +457,10 @@ void matrix_init(void) {
 
     debounce_init(ROWS_PER_HAND);
 
+#ifdef MATRIX_SCAN_EVENT_DRIVEN
+    matrix_event_init();
+#endif
+
     matrix_init_kb();
 }
 
@@ -339,10 +491,14 @@ uint8_t matrix_scan(void) {
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
+    SCAN_PROFILE_BEGIN(debounce_start);
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    SCAN_PROFILE_END(SCAN_PROFILE_DEBOUNCE, debounce_start);
+    changed |= matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    SCAN_PROFILE_END(SCAN_PROFILE_DEBOUNCE, debounce_start);
     matrix_scan_kb();
 #endif
     return (uint8_t)changed;
@@ -69,6 +69,17 @@ void matrix_io_delay(void);
 void matrix_power_up(void);
 void matrix_power_down(void);
 
+#ifdef MATRIX_SCAN_EVENT_DRIVEN
+#    ifndef MATRIX_SCAN_EVENT_TIMEOUT
+#        define MATRIX_SCAN_EVENT_TIMEOUT 10
+#    endif
+
+/* true once every switch has been released and debounced for MATRIX_SCAN_EVENT_IDLE_TIME */
+bool matrix_scan_is_idle(void);
+/* sleep until a matrix pin changes state, or MATRIX_SCAN_EVENT_TIMEOUT expires */
+void matrix_wait_for_event(void);
+#endif
+
 void matrix_init_kb(void);
 void matrix_scan_kb(void);
 
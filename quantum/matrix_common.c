@@ -1,8 +1,10 @@
 #include "matrix.h"
 #include "debounce.h"
+#include "scan_profile.h"
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
+#include "keyboard.h"
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -97,7 +99,10 @@ bool matrix_post_scan(void) {
     if (is_keyboard_master()) {
         static bool  last_connected              = false;
         matrix_row_t slave_matrix[ROWS_PER_HAND] = {0};
-        if (transport_master_if_connected(matrix + thisHand, slave_matrix)) {
+        SCAN_PROFILE_BEGIN(transport_start);
+        bool connected = transport_master_if_connected(matrix + thisHand, slave_matrix);
+        SCAN_PROFILE_END(SCAN_PROFILE_SPLIT_TRANSACTIONS, transport_start);
+        if (connected) {
             changed = memcmp(matrix + thatHand, slave_matrix, sizeof(slave_matrix)) != 0;
 
             last_connected = true;
@@ -113,7 +118,9 @@ bool matrix_post_scan(void) {
 
         matrix_scan_kb();
     } else {
+        SCAN_PROFILE_BEGIN(transport_start);
         transport_slave(matrix + thatHand, matrix + thisHand);
+        SCAN_PROFILE_END(SCAN_PROFILE_SPLIT_TRANSACTIONS, transport_start);
 
         matrix_slave_scan_kb();
     }
@@ -133,6 +140,38 @@ __attribute__((weak)) void matrix_output_unselect_delay(uint8_t line, bool key_p
     matrix_io_delay();
 }
 
+#ifdef MATRIX_SCAN_EVENT_DRIVEN
+#    ifndef MATRIX_SCAN_EVENT_IDLE_TIME
+#        define MATRIX_SCAN_EVENT_IDLE_TIME 50
+#    endif
+
+// Custom matrices provide their own pin-change wait; without one the scan loop keeps polling.
+__attribute__((weak)) void matrix_wait_for_event(void) {}
+
+bool matrix_scan_is_idle(void) {
+#    if defined(SPLIT_KEYBOARD) && !defined(SPLIT_EVENT_PIN)
+    // Nothing would wake the master for a keypress on the other half
+    if (is_keyboard_master()) {
+        return false;
+    }
+#    endif
+    if (last_matrix_activity_elapsed() < MATRIX_SCAN_EVENT_IDLE_TIME) {
+        return false;
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix[row]) {
+            return false;
+        }
+    }
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 // CUSTOM MATRIX 'LITE'
 __attribute__((weak)) void matrix_init_custom(void) {}
 __attribute__((weak)) bool matrix_scan_custom(matrix_row_t current_matrix[]) {
@@ -168,10 +207,14 @@ __attribute__((weak)) void matrix_init(void) {
 __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
 
+    SCAN_PROFILE_BEGIN(debounce_start);
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    SCAN_PROFILE_END(SCAN_PROFILE_DEBOUNCE, debounce_start);
+    changed |= matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    SCAN_PROFILE_END(SCAN_PROFILE_DEBOUNCE, debounce_start);
     matrix_scan_kb();
 #endif
 
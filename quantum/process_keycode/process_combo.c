@@ -301,6 +301,118 @@ static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keyc
     }
 }
 
+#ifdef COMBO_INDEXED
+/* Total number of keys across all combos that the keycode index can hold */
+#    ifndef COMBO_INDEX_SIZE
+#        ifdef VIAL_COMBO_ENABLE
+#            define COMBO_INDEX_SIZE (VIAL_COMBO_ENTRIES * 4)
+#        else
+#            define COMBO_INDEX_SIZE 128
+#        endif
+#    endif
+
+/* Inverted index of every combo key, sorted by keycode and then combo index,
+ * so the combos a keycode takes part in can be found with a binary search
+ * instead of scanning every combo. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_index_entry_t;
+
+static combo_index_entry_t combo_index_entries[COMBO_INDEX_SIZE];
+static uint16_t            combo_index_entry_count = 0;
+static uint16_t            combo_index_combo_count = 0;
+static bool                combo_index_valid       = false;
+
+void combo_index_rebuild(void) {
+    combo_index_entry_count = 0;
+    combo_index_combo_count = combo_count();
+    combo_index_valid       = true;
+
+    for (uint16_t idx = 0; idx < combo_index_combo_count; ++idx) {
+        combo_t *combo     = combo_get(idx);
+        uint8_t  key_count = 0;
+        while (COMBO_END != pgm_read_word(&combo->keys[key_count])) {
+            key_count++;
+        }
+
+        for (uint8_t key_index = 0; key_index < key_count; ++key_index) {
+            uint16_t key = pgm_read_word(&combo->keys[key_index]);
+
+            /* A keycode listed twice in a combo maps to its last position, as in _find_key_index_and_count() */
+            bool duplicate = false;
+            for (uint8_t later = key_index + 1; later < key_count; ++later) {
+                if (pgm_read_word(&combo->keys[later]) == key) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (duplicate) {
+                continue;
+            }
+
+            if (combo_index_entry_count >= COMBO_INDEX_SIZE) {
+                /* Doesn't fit, fall back to scanning every combo */
+                combo_index_valid = false;
+                return;
+            }
+
+            /* Insertion sort, entries are added in combo order so ties stay ordered by combo index */
+            uint16_t i = combo_index_entry_count++;
+            while (i > 0 && combo_index_entries[i - 1].keycode > key) {
+                combo_index_entries[i] = combo_index_entries[i - 1];
+                i--;
+            }
+            combo_index_entries[i] = (combo_index_entry_t){
+                .keycode     = key,
+                .combo_index = idx,
+                .key_index   = key_index,
+                .key_count   = key_count,
+            };
+        }
+    }
+}
+
+static inline bool combo_index_ready(void) {
+    if (combo_index_combo_count != combo_count()) {
+        combo_index_rebuild();
+    }
+    return combo_index_valid;
+}
+
+/* Returns the position of the first entry for keycode, or combo_index_entry_count if there is none. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_index_entry_count;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_index_entries[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return (low < combo_index_entry_count && combo_index_entries[low].keycode == keycode) ? low : combo_index_entry_count;
+}
+#endif
+
+static inline void find_combo_key(uint16_t combo_index, combo_t *combo, uint16_t keycode, uint16_t *key_index, uint8_t *key_count) {
+#ifdef COMBO_INDEXED
+    if (combo_index_ready()) {
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_entry_count && combo_index_entries[i].keycode == keycode; ++i) {
+            if (combo_index_entries[i].combo_index == combo_index) {
+                *key_index = combo_index_entries[i].key_index;
+                *key_count = combo_index_entries[i].key_count;
+                return;
+            }
+        }
+        return;
+    }
+#endif
+    _find_key_index_and_count(combo->keys, keycode, key_index, key_count);
+}
+
 void drop_combo_from_buffer(uint16_t combo_index) {
     /* Mark a combo as processed from the buffer. If the buffer is in the
      * beginning of the buffer, drop it.  */
@@ -345,7 +457,7 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
 
         uint8_t  key_count = 0;
         uint16_t key_index = -1;
-        _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+        find_combo_key(combo_index, combo, keycode, &key_index, &key_count);
 
         if (-1 == (int16_t)key_index) {
             // key not part of this combo
@@ -437,16 +549,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_single_combo_key(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint16_t key_index, uint8_t key_count) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -557,6 +660,19 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_single_combo_key(combo, keycode, record, combo_index, key_index, key_count);
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -587,10 +703,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEXED
+    if (combo_index_ready()) {
+        /* Only the combos containing this keycode can be affected by it */
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_entry_count && combo_index_entries[i].keycode == keycode; ++i) {
+            const combo_index_entry_t *entry = &combo_index_entries[i];
+            is_combo_key |= process_single_combo_key(combo_get(entry->combo_index), keycode, record, entry->combo_index, entry->key_index, entry->key_count);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
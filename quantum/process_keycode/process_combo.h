@@ -81,3 +81,8 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_INDEXED
+/* Rebuilds the keycode index, must be called after the keys of any combo change */
+void combo_index_rebuild(void);
+#endif
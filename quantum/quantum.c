@@ -199,6 +199,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -239,10 +242,10 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
         } else {
             layer = read_source_layers_cache(event.key);
         }
-        return keymap_key_to_keycode(layer, event.key);
+        return effective_keymap_get_keycode(layer, event.key);
     } else
 #endif
-        return keymap_key_to_keycode(layer_switch_get_layer(event.key), event.key);
+        return effective_keymap_get_keycode(layer_switch_get_layer(event.key), event.key);
 }
 
 /* Get keycode, and then process pre tapping functionality */
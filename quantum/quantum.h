@@ -66,6 +66,10 @@
 #    include "deferred_exec.h"
 #endif
 
+#ifdef SCAN_PROFILE_ENABLE
+#    include "scan_profile.h"
+#endif
+
 extern layer_state_t default_layer_state;
 
 #ifndef NO_ACTION_LAYER
@@ -1,6 +1,7 @@
 #ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
 #define RGB_MATRIX_EFFECT_ALPHAS_MODS
 RGB_MATRIX_EFFECT(ALPHAS_MODS)
+RGB_MATRIX_EFFECT_MAX_FPS(ALPHAS_MODS, 20)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 // alphas = color1, mods = color2
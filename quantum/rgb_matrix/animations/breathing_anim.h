@@ -1,6 +1,7 @@
 #ifdef ENABLE_RGB_MATRIX_BREATHING
 #define RGB_MATRIX_EFFECT_BREATHING
 RGB_MATRIX_EFFECT(BREATHING)
+RGB_MATRIX_EFFECT_MAX_FPS(BREATHING, 30)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 bool BREATHING(effect_params_t* params) {
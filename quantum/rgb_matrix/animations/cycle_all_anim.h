@@ -1,6 +1,7 @@
 #ifdef ENABLE_RGB_MATRIX_CYCLE_ALL
 #define RGB_MATRIX_EFFECT_CYCLE_ALL
 RGB_MATRIX_EFFECT(CYCLE_ALL)
+RGB_MATRIX_EFFECT_MAX_FPS(CYCLE_ALL, 30)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static HSV CYCLE_ALL_math(HSV hsv, uint8_t i, uint8_t time) {
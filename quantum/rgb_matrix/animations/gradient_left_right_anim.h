@@ -1,6 +1,7 @@
 #ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
 #define RGB_MATRIX_EFFECT_GRADIENT_LEFT_RIGHT
 RGB_MATRIX_EFFECT(GRADIENT_LEFT_RIGHT)
+RGB_MATRIX_EFFECT_MAX_FPS(GRADIENT_LEFT_RIGHT, 20)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 bool GRADIENT_LEFT_RIGHT(effect_params_t* params) {
@@ -1,6 +1,7 @@
 #ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
 #define RGB_MATRIX_EFFECT_GRADIENT_UP_DOWN
 RGB_MATRIX_EFFECT(GRADIENT_UP_DOWN)
+RGB_MATRIX_EFFECT_MAX_FPS(GRADIENT_UP_DOWN, 20)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 bool GRADIENT_UP_DOWN(effect_params_t* params) {
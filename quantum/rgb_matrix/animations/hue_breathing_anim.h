@@ -1,6 +1,7 @@
 #ifdef ENABLE_RGB_MATRIX_HUE_BREATHING
 #define RGB_MATRIX_EFFECT_HUE_BREATHING
 RGB_MATRIX_EFFECT(HUE_BREATHING)
+RGB_MATRIX_EFFECT_MAX_FPS(HUE_BREATHING, 30)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 // Change huedelta to adjust range of hue change. 0-255.
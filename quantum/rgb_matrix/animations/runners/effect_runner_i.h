@@ -6,10 +6,11 @@ bool effect_runner_i(effect_params_t* params, i_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint8_t time = scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed / 4, 1));
+    RGB_MATRIX_HSV_SPAN(span);
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
-        RGB rgb = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, i, time));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        RGB_MATRIX_HSV_SPAN_SET(span, i, effect_func(rgb_matrix_config.hsv, i, time));
     }
+    RGB_MATRIX_HSV_SPAN_FLUSH(span);
     return rgb_matrix_check_finished_leds(led_max);
 }
@@ -1,5 +1,6 @@
 #define RGB_MATRIX_EFFECT_SOLID_COLOR
 RGB_MATRIX_EFFECT(SOLID_COLOR)
+RGB_MATRIX_EFFECT_MAX_FPS(SOLID_COLOR, 20)
 #ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 bool SOLID_COLOR(effect_params_t* params) {
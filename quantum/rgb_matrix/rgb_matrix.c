@@ -29,6 +29,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#if defined(RGB_MATRIX_RENDER_BUDGET_US) && defined(PROTOCOL_CHIBIOS)
+#    include <hal.h>
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -39,6 +43,21 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+#ifdef RGB_MATRIX_HSV_BATCH
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
+
+void rgb_matrix_hsv_span_flush(rgb_matrix_hsv_span_t *span) {
+    RGB rgb[RGB_MATRIX_HSV_SPAN_LENGTH];
+    rgb_matrix_hsv_to_rgb_batch(span->hsv, rgb, span->count);
+    for (uint8_t i = 0; i < span->count; i++) {
+        rgb_matrix_set_color(span->led[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    span->count = 0;
+}
+#endif
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -70,6 +89,11 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+uint8_t g_rgb_led_distance[(RGB_MATRIX_LED_COUNT * (RGB_MATRIX_LED_COUNT - 1)) / 2];
+uint8_t g_rgb_center_distance[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_LED_DISTANCE_TABLE
+
 // internals
 static bool            suspend_state     = false;
 static uint8_t         rgb_last_enable   = UINT8_MAX;
@@ -139,11 +163,150 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+// FNV-1a hash of every color written since the last flush. Writing the same
+// colors to the same LEDs again leaves them unchanged, so a frame whose writes
+// hash the same as the previous frame's does not need to be flushed.
+static uint32_t rgb_frame_hash   = 2166136261UL;
+static uint32_t rgb_flushed_hash = 0;
+static bool     rgb_flush_forced = true;
+
+static void rgb_frame_hash_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    uint8_t data[] = {index & 0xFF, (index >> 8) & 0xFF, red, green, blue};
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        rgb_frame_hash = (rgb_frame_hash ^ data[i]) * 16777619UL;
+    }
+}
+
+void rgb_matrix_flush_deferred(void) {
+    rgb_flush_forced = true;
+}
+#endif
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+#    define RGB_MATRIX_OVERLAY_MASK_SIZE ((RGB_MATRIX_LED_COUNT + 7) / 8)
+
+typedef struct {
+    uint8_t leds[RGB_MATRIX_OVERLAY_MASK_SIZE];
+    RGB     color;
+    uint8_t blend;
+    uint8_t alpha;
+    bool    enabled;
+} rgb_overlay_t;
+
+static rgb_overlay_t rgb_overlays[RGB_MATRIX_OVERLAY_COUNT];
+// LEDs affected by any enabled overlay, so that every other LED costs one bit test
+static uint8_t rgb_overlay_leds[RGB_MATRIX_OVERLAY_MASK_SIZE];
+static bool    rgb_overlay_any         = false;
+static bool    rgb_overlay_compositing = false;
+
+static inline bool rgb_overlay_has_led(const uint8_t *leds, uint8_t index) {
+    return leds[index / 8] & (1 << (index % 8));
+}
+
+static void rgb_overlay_update_leds(void) {
+    memset(rgb_overlay_leds, 0, sizeof(rgb_overlay_leds));
+    rgb_overlay_any = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_OVERLAY_COUNT; i++) {
+        if (!rgb_overlays[i].enabled) {
+            continue;
+        }
+        for (uint8_t j = 0; j < RGB_MATRIX_OVERLAY_MASK_SIZE; j++) {
+            rgb_overlay_leds[j] |= rgb_overlays[i].leds[j];
+            rgb_overlay_any |= rgb_overlays[i].leds[j] != 0;
+        }
+    }
+}
+
+static inline uint8_t rgb_overlay_blend_channel(uint8_t blend, uint8_t alpha, uint8_t base, uint8_t over) {
+    switch (blend) {
+        case RGB_MATRIX_BLEND_ADD:
+            return qadd8(base, over);
+        case RGB_MATRIX_BLEND_MULTIPLY:
+            // scaled so that multiplying by 255 leaves the color unchanged
+            return ((uint16_t)base * (over + 1)) >> 8;
+        case RGB_MATRIX_BLEND_ALPHA:
+            return blend8(base, over, alpha);
+        default:
+            return over;
+    }
+}
+
+/** \brief Applies the enabled overlays covering the LED to a color the effect writes
+ *
+ * Overlays are applied in order, each one on top of the result of the previous.
+ */
+static void rgb_overlay_composite(uint8_t index, uint8_t *red, uint8_t *green, uint8_t *blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_OVERLAY_COUNT; i++) {
+        const rgb_overlay_t *overlay = &rgb_overlays[i];
+        if (!overlay->enabled || !rgb_overlay_has_led(overlay->leds, index)) {
+            continue;
+        }
+        *red   = rgb_overlay_blend_channel(overlay->blend, overlay->alpha, *red, overlay->color.r);
+        *green = rgb_overlay_blend_channel(overlay->blend, overlay->alpha, *green, overlay->color.g);
+        *blue  = rgb_overlay_blend_channel(overlay->blend, overlay->alpha, *blue, overlay->color.b);
+    }
+}
+
+void rgb_matrix_overlay_set_color(uint8_t overlay, uint8_t red, uint8_t green, uint8_t blue) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    rgb_overlays[overlay].color.r = red;
+    rgb_overlays[overlay].color.g = green;
+    rgb_overlays[overlay].color.b = blue;
+}
+
+void rgb_matrix_overlay_set_blend(uint8_t overlay, uint8_t blend, uint8_t alpha) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    rgb_overlays[overlay].blend = blend;
+    rgb_overlays[overlay].alpha = alpha;
+}
+
+void rgb_matrix_overlay_set_led(uint8_t overlay, uint8_t index, bool affected) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT || index >= RGB_MATRIX_LED_COUNT) return;
+    if (affected) {
+        rgb_overlays[overlay].leds[index / 8] |= (1 << (index % 8));
+    } else {
+        rgb_overlays[overlay].leds[index / 8] &= ~(1 << (index % 8));
+    }
+    rgb_overlay_update_leds();
+}
+
+void rgb_matrix_overlay_clear(uint8_t overlay) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    memset(rgb_overlays[overlay].leds, 0, sizeof(rgb_overlays[overlay].leds));
+    rgb_overlay_update_leds();
+}
+
+void rgb_matrix_overlay_enable(uint8_t overlay) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    rgb_overlays[overlay].enabled = true;
+    rgb_overlay_update_leds();
+}
+
+void rgb_matrix_overlay_disable(uint8_t overlay) {
+    if (overlay >= RGB_MATRIX_OVERLAY_COUNT) return;
+    rgb_overlays[overlay].enabled = false;
+    rgb_overlay_update_leds();
+}
+
+bool rgb_matrix_overlay_is_enabled(uint8_t overlay) {
+    return overlay < RGB_MATRIX_OVERLAY_COUNT && rgb_overlays[overlay].enabled;
+}
+#endif // RGB_MATRIX_OVERLAY_COUNT
+
 void rgb_matrix_update_pwm_buffers(void) {
     rgb_matrix_driver.flush();
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+    if (rgb_overlay_compositing && index >= 0 && index < RGB_MATRIX_LED_COUNT && rgb_overlay_has_led(rgb_overlay_leds, index)) {
+        rgb_overlay_composite(index, &red, &green, &blue);
+    }
+#endif
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_color(index, red, green, blue);
+#endif
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
@@ -152,6 +315,16 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_OVERLAY_COUNT
+    if (rgb_overlay_compositing && rgb_overlay_any) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+            rgb_matrix_set_color(i, red, green, blue);
+        return;
+    }
+#    endif
+#    ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_color(-1, red, green, blue);
+#    endif
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
@@ -258,10 +431,55 @@ static void rgb_task_timers(void) {
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void rgb_task_sync(void) {
+#ifdef RGB_MATRIX_ADAPTIVE_FPS
+// ---------------------------------------------
+// -----Begin rgb effect frame rate macros------
+#    undef RGB_MATRIX_EFFECT_MAX_FPS
+#    define RGB_MATRIX_EFFECT(name, ...)
+#    define RGB_MATRIX_EFFECT_MAX_FPS(name, fps) [RGB_MATRIX_##name] = fps,
+// Highest useful frame rate of each effect, 0 when it did not declare one
+static const uint8_t rgb_effect_max_fps[RGB_MATRIX_EFFECT_MAX] PROGMEM = {
+#    include "rgb_matrix_effects.inc"
+#    if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#        undef RGB_MATRIX_EFFECT_MAX_FPS
+#        define RGB_MATRIX_EFFECT_MAX_FPS(name, fps) [RGB_MATRIX_CUSTOM_##name] = fps,
+#        ifdef RGB_MATRIX_CUSTOM_KB
+#            include "rgb_matrix_kb.inc"
+#        endif
+#        ifdef RGB_MATRIX_CUSTOM_USER
+#            include "rgb_matrix_user.inc"
+#        endif
+#    endif
+};
+#    undef RGB_MATRIX_EFFECT
+#    undef RGB_MATRIX_EFFECT_MAX_FPS
+#    define RGB_MATRIX_EFFECT_MAX_FPS(name, fps)
+// -----End rgb effect frame rate macros--------
+// ---------------------------------------------
+
+/** \brief Milliseconds to wait between two frames of the effect
+ *
+ * Never less than RGB_MATRIX_LED_FLUSH_LIMIT. Effects that declared a lower
+ * maximum frame rate run at that rate, and all effects drop to
+ * RGB_MATRIX_IDLE_FPS once there has been no input for RGB_MATRIX_IDLE_TIMEOUT.
+ * Input brings the full rate back on the next frame.
+ */
+static uint32_t rgb_task_flush_limit(uint8_t effect) {
+    uint8_t fps = effect < RGB_MATRIX_EFFECT_MAX ? pgm_read_byte(&rgb_effect_max_fps[effect]) : 0;
+    if (last_input_activity_elapsed() > RGB_MATRIX_IDLE_TIMEOUT && (fps == 0 || fps > RGB_MATRIX_IDLE_FPS)) {
+        fps = RGB_MATRIX_IDLE_FPS;
+    }
+    uint32_t limit = fps ? 1000 / fps : 0;
+    return limit > RGB_MATRIX_LED_FLUSH_LIMIT ? limit : RGB_MATRIX_LED_FLUSH_LIMIT;
+}
+#else
+#    define rgb_task_flush_limit(effect) RGB_MATRIX_LED_FLUSH_LIMIT
+#endif // RGB_MATRIX_ADAPTIVE_FPS
+
+static void rgb_task_sync(uint8_t effect) {
     eeconfig_flush_rgb_matrix(false);
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (sync_timer_elapsed32(g_rgb_timer) >= rgb_task_flush_limit(effect)) rgb_task_state = STARTING;
 }
 
 static void rgb_task_start(void) {
@@ -278,6 +496,87 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+// Per-LED render cost of the running effect, in 1/16 microseconds
+static uint32_t                   rgb_render_cost_q4     = 0;
+static uint8_t                    rgb_render_cost_effect = UINT8_MAX;
+static uint8_t                    rgb_render_slice_iter  = 0;
+static struct rgb_matrix_limits_t rgb_render_slice       = {0};
+
+#    if defined(PROTOCOL_CHIBIOS) && (HAL_IMPLEMENTS_COUNTERS == TRUE)
+__attribute__((weak)) uint32_t rgb_matrix_render_ticks(void) {
+    return (uint32_t)halGetCounterValue();
+}
+
+static uint32_t rgb_render_ticks_to_us_q4(uint32_t ticks) {
+    uint32_t frequency = (uint32_t)halGetCounterFrequency();
+    return (uint64_t)ticks * 16000000 / frequency;
+}
+#    else
+// No free-running counter available, fall back to the millisecond timer. Slices
+// that happen to straddle a tick make the average cost come out right over time.
+__attribute__((weak)) uint32_t rgb_matrix_render_ticks(void) {
+    return timer_read32();
+}
+
+static uint32_t rgb_render_ticks_to_us_q4(uint32_t ticks) {
+    return ticks * 16000;
+}
+#    endif
+
+/** \brief Picks the LEDs to render this slice
+ *
+ * Sizes the slice so that, at the running effect's measured per-LED cost, it
+ * fits in RGB_MATRIX_RENDER_BUDGET_US. Until a cost has been measured the slice
+ * is RGB_MATRIX_LED_PROCESS_LIMIT LEDs.
+ */
+static void rgb_render_slice_begin(uint8_t effect) {
+    if (effect != rgb_render_cost_effect) {
+        rgb_render_cost_effect = effect;
+        rgb_render_cost_q4     = 0;
+    }
+
+    uint8_t lo = 0;
+    uint8_t hi = RGB_MATRIX_LED_COUNT;
+#    if defined(RGB_MATRIX_SPLIT)
+    const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+    if (is_keyboard_left()) {
+        hi = k_rgb_matrix_split[0];
+    } else {
+        lo = k_rgb_matrix_split[0];
+    }
+#    endif
+
+    uint16_t count = RGB_MATRIX_LED_PROCESS_LIMIT;
+    if (rgb_render_cost_q4 > 0) {
+        uint32_t fit = ((uint32_t)RGB_MATRIX_RENDER_BUDGET_US * 16) / rgb_render_cost_q4;
+        count        = fit < 1 ? 1 : (fit > RGB_MATRIX_LED_COUNT ? RGB_MATRIX_LED_COUNT : fit);
+    }
+
+    uint8_t min                    = rgb_effect_params.iter == 0 ? lo : rgb_render_slice.led_max_index;
+    rgb_render_slice_iter          = rgb_effect_params.iter;
+    rgb_render_slice.led_min_index = min;
+    rgb_render_slice.led_max_index = (hi - min) < count ? hi : min + count;
+}
+
+static void rgb_render_slice_end(uint32_t start) {
+    uint8_t count = rgb_render_slice.led_max_index - rgb_render_slice.led_min_index;
+    if (count == 0) {
+        return;
+    }
+    uint32_t sample = rgb_render_ticks_to_us_q4(rgb_matrix_render_ticks() - start) / count;
+    if (rgb_render_cost_q4 == 0) {
+        rgb_render_cost_q4 = sample ? sample : 1;
+    } else {
+        // Smooth over a few slices so one interrupt doesn't shrink the next slice to nothing
+        rgb_render_cost_q4 = (rgb_render_cost_q4 * 3 + sample) / 4;
+        if (rgb_render_cost_q4 == 0) {
+            rgb_render_cost_q4 = 1;
+        }
+    }
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
@@ -286,6 +585,11 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_slice_begin(effect);
+    uint32_t render_start = rgb_matrix_render_ticks();
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -326,6 +630,10 @@ static void rgb_task_render(uint8_t effect) {
             return;
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_slice_end(render_start);
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
     rgb_effect_params.iter++;
 
     // next task
@@ -344,7 +652,17 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    bool changed     = rgb_flush_forced || rgb_frame_hash != rgb_flushed_hash;
+    rgb_flushed_hash = rgb_frame_hash;
+    rgb_frame_hash   = 2166136261UL;
+    rgb_flush_forced = false;
+    if (changed) {
+        rgb_matrix_update_pwm_buffers();
+    }
+#else
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -368,7 +686,14 @@ void rgb_matrix_task(void) {
             rgb_task_start();
             break;
         case RENDERING:
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+            // overlays only apply to what the effect draws, not to the indicators or to the LEDs being switched off
+            rgb_overlay_compositing = effect != RGB_MATRIX_NONE;
+            rgb_task_render(effect);
+            rgb_overlay_compositing = false;
+#else
             rgb_task_render(effect);
+#endif
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
@@ -380,7 +705,7 @@ void rgb_matrix_task(void) {
             rgb_task_flush(effect);
             break;
         case SYNCING:
-            rgb_task_sync();
+            rgb_task_sync(effect);
             break;
     }
 }
@@ -399,6 +724,11 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    if (iter == rgb_render_slice_iter) {
+        return rgb_render_slice;
+    }
+#endif // RGB_MATRIX_RENDER_BUDGET_US
 #if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
@@ -445,8 +775,37 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+/** \brief Fills the distance tables from g_led_config
+ *
+ * Runs once at init. Keyboards that change g_led_config.point afterwards must
+ * call it again.
+ */
+void rgb_matrix_init_distance_tables(void) {
+    uint16_t n = 0;
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        int16_t dx = g_led_config.point[a].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[a].y - k_rgb_matrix_center.y;
+
+        g_rgb_center_distance[a] = sqrt16(dx * dx + dy * dy);
+        for (uint8_t b = a + 1; b < RGB_MATRIX_LED_COUNT; b++) {
+            dx                      = g_led_config.point[a].x - g_led_config.point[b].x;
+            dy                      = g_led_config.point[a].y - g_led_config.point[b].y;
+            g_rgb_led_distance[n++] = sqrt16(dx * dx + dy * dy);
+        }
+    }
+}
+#endif // RGB_MATRIX_LED_DISTANCE_TABLE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_flush_forced = true;
+#endif
+
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    rgb_matrix_init_distance_tables();
+#endif // RGB_MATRIX_LED_DISTANCE_TABLE
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -97,6 +97,49 @@ struct rgb_matrix_limits_t {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+// called by a driver that could not flush yet, so the next frame is flushed even if unchanged
+void rgb_matrix_flush_deferred(void);
+#endif
+
+#ifdef RGB_MATRIX_OVERLAY_COUNT
+enum rgb_matrix_blend_modes {
+    RGB_MATRIX_BLEND_REPLACE,  // the overlay color replaces the effect's
+    RGB_MATRIX_BLEND_ADD,      // the overlay color is added to the effect's, saturating
+    RGB_MATRIX_BLEND_MULTIPLY, // the effect's color is scaled by the overlay color
+    RGB_MATRIX_BLEND_ALPHA,    // the overlay color is mixed into the effect's by the overlay alpha
+};
+
+void rgb_matrix_overlay_set_color(uint8_t overlay, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_overlay_set_blend(uint8_t overlay, uint8_t blend, uint8_t alpha);
+void rgb_matrix_overlay_set_led(uint8_t overlay, uint8_t index, bool affected);
+void rgb_matrix_overlay_clear(uint8_t overlay);
+void rgb_matrix_overlay_enable(uint8_t overlay);
+void rgb_matrix_overlay_disable(uint8_t overlay);
+bool rgb_matrix_overlay_is_enabled(uint8_t overlay);
+#endif
+
+#ifdef RGB_MATRIX_ADAPTIVE_FPS
+#    ifndef RGB_MATRIX_IDLE_TIMEOUT
+#        define RGB_MATRIX_IDLE_TIMEOUT 5000
+#    endif
+#    ifndef RGB_MATRIX_IDLE_FPS
+#        define RGB_MATRIX_IDLE_FPS 15
+#    endif
+#endif
+
+// Declares the highest frame rate at which the effect still looks smooth. Only
+// has an effect with RGB_MATRIX_ADAPTIVE_FPS, which defines it while building
+// the table of these rates.
+#ifndef RGB_MATRIX_EFFECT_MAX_FPS
+#    define RGB_MATRIX_EFFECT_MAX_FPS(name, fps)
+#endif
+
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+// free-running counter used to measure render cost, override to provide a finer one
+uint32_t rgb_matrix_render_ticks(void);
+#endif
+
 #define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                   \
     struct rgb_matrix_limits_t limits = rgb_matrix_get_limits(iter); \
     uint8_t                    min    = limits.led_min_index;        \
@@ -114,6 +157,41 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+#ifdef RGB_MATRIX_HSV_BATCH
+#    ifndef RGB_MATRIX_HSV_SPAN_LENGTH
+#        define RGB_MATRIX_HSV_SPAN_LENGTH 16
+#    endif
+
+typedef struct {
+    uint8_t count;
+    uint8_t led[RGB_MATRIX_HSV_SPAN_LENGTH];
+    HSV     hsv[RGB_MATRIX_HSV_SPAN_LENGTH];
+} rgb_matrix_hsv_span_t;
+
+// converts every pending HSV value with rgb_matrix_hsv_to_rgb_batch and writes it to its LED
+void rgb_matrix_hsv_span_flush(rgb_matrix_hsv_span_t *span);
+void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+
+#    define RGB_MATRIX_HSV_SPAN(span) rgb_matrix_hsv_span_t span = {.count = 0}
+#    define RGB_MATRIX_HSV_SPAN_SET(span, index, value)         \
+        do {                                                    \
+            span.led[span.count]   = index;                     \
+            span.hsv[span.count++] = value;                     \
+            if (span.count == RGB_MATRIX_HSV_SPAN_LENGTH) {     \
+                rgb_matrix_hsv_span_flush(&span);               \
+            }                                                   \
+        } while (0)
+#    define RGB_MATRIX_HSV_SPAN_FLUSH(span) rgb_matrix_hsv_span_flush(&span)
+#else
+#    define RGB_MATRIX_HSV_SPAN(span)
+#    define RGB_MATRIX_HSV_SPAN_SET(span, index, value)                               \
+        do {                                                                          \
+            RGB span##_rgb = rgb_matrix_hsv_to_rgb(value);                            \
+            rgb_matrix_set_color(index, span##_rgb.r, span##_rgb.g, span##_rgb.b);    \
+        } while (0)
+#    define RGB_MATRIX_HSV_SPAN_FLUSH(span)
+#endif
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -278,6 +356,32 @@ extern last_hit_t g_last_hit_tracker;
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
 
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+// LED-to-LED distances, packed as the upper triangle of the symmetric matrix
+extern uint8_t g_rgb_led_distance[(RGB_MATRIX_LED_COUNT * (RGB_MATRIX_LED_COUNT - 1)) / 2];
+extern uint8_t g_rgb_center_distance[RGB_MATRIX_LED_COUNT];
+
+void rgb_matrix_init_distance_tables(void);
+
+/** \brief Same result as sqrt16(dx * dx + dy * dy) between the two LEDs' points, from the table */
+static inline uint8_t rgb_matrix_led_distance(uint8_t led_a, uint8_t led_b) {
+    if (led_a == led_b) {
+        return 0;
+    }
+    if (led_a > led_b) {
+        uint8_t swap = led_a;
+        led_a        = led_b;
+        led_b        = swap;
+    }
+    return g_rgb_led_distance[(uint16_t)led_a * (2 * RGB_MATRIX_LED_COUNT - led_a - 1) / 2 + (led_b - led_a - 1)];
+}
+
+/** \brief Same result as sqrt16(dx * dx + dy * dy) between the LED's point and k_rgb_matrix_center, from the table */
+static inline uint8_t rgb_matrix_center_distance(uint8_t led) {
+    return g_rgb_center_distance[led];
+}
+#endif
+
 #if !defined(RGB_MATRIX_MAXIMUM_BRIGHTNESS) || RGB_MATRIX_MAXIMUM_BRIGHTNESS > UINT8_MAX
 #    undef RGB_MATRIX_MAXIMUM_BRIGHTNESS
 #    define RGB_MATRIX_MAXIMUM_BRIGHTNESS UINT8_MAX
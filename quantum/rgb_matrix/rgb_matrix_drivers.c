@@ -20,6 +20,7 @@
 #include "keyboard.h"
 #include "color.h"
 #include "util.h"
+#include "rgb_matrix.h"
 
 /* Each driver needs to define the struct
  *    const rgb_matrix_driver_t rgb_matrix_driver;
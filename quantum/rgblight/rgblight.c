@@ -128,6 +128,12 @@ static bool deferred_set_layer_state = false;
 
 rgblight_ranges_t rgblight_ranges = {0, RGBLIGHT_LED_COUNT, 0, RGBLIGHT_LED_COUNT, RGBLIGHT_LED_COUNT};
 
+#ifdef RGBLIGHT_SKIP_UNCHANGED_FRAMES
+// FNV-1a hash of the last data sent to the strip, which still shows it
+static uint32_t rgblight_sent_hash   = 0;
+static bool     rgblight_send_forced = true;
+#endif
+
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.clipping_start_pos = start_pos;
     rgblight_ranges.clipping_num_leds  = num_leds;
@@ -353,6 +359,9 @@ void rgblight_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     }
 #ifdef RGBLIGHT_USE_TIMER
     animation_status.restart = true;
+#    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
+    rgblight_status.animation_start = sync_timer_read();
+#    endif
 #endif
     rgblight_sethsv_noeeprom(rgblight_config.hue, rgblight_config.sat, rgblight_config.val);
 }
@@ -878,6 +887,10 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+#    ifdef RGBLIGHT_SKIP_UNCHANGED_FRAMES
+    // the strip may have lost power while suspended
+    rgblight_send_forced = true;
+#    endif
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -936,6 +949,19 @@ void rgblight_set(void) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
 #endif
+
+#ifdef RGBLIGHT_SKIP_UNCHANGED_FRAMES
+    uint32_t       hash = (2166136261UL ^ rgblight_ranges.clipping_start_pos) * 16777619UL;
+    const uint8_t *data = (const uint8_t *)start_led;
+    for (uint16_t i = 0; i < num_leds * sizeof(rgb_led_t); i++) {
+        hash = (hash ^ data[i]) * 16777619UL;
+    }
+    if (!rgblight_send_forced && hash == rgblight_sent_hash) {
+        return;
+    }
+    rgblight_sent_hash   = hash;
+    rgblight_send_forced = false;
+#endif
     rgblight_driver.setleds(start_led, num_leds);
 }
 
@@ -965,6 +991,10 @@ void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
         if (syncinfo->config.enable) {
             rgblight_config.enable = 1; // == rgblight_enable_noeeprom();
             rgblight_mode_eeprom_helper(syncinfo->config.mode, write_to_eeprom);
+#    if defined(RGBLIGHT_USE_TIMER) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
+            // start from the same tick as the master, so both halves stay in step on their own
+            rgblight_status.animation_start = syncinfo->status.animation_start;
+#    endif
         } else {
             rgblight_disable_noeeprom();
         }
@@ -983,7 +1013,9 @@ void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
     }
 #        ifndef RGBLIGHT_SPLIT_NO_ANIMATION_SYNC
     if (syncinfo->status.change_flags & RGBLIGHT_STATUS_ANIMATION_TICK) {
-        animation_status.restart = true;
+        // periodic resync, so a slave that restarted mid-animation falls back in step
+        rgblight_status.animation_start = syncinfo->status.animation_start;
+        animation_status.restart        = true;
     }
 #        endif /* RGBLIGHT_SPLIT_NO_ANIMATION_SYNC */
 #    endif     /* RGBLIGHT_USE_TIMER */
@@ -1111,31 +1143,38 @@ void rgblight_timer_task(void) {
         }
 #    endif
         if (animation_status.restart) {
-            animation_status.restart    = false;
+            animation_status.restart = false;
+#    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
+            // Both halves run the animation from the same point on the shared
+            // sync timer, so they stay in step between the periodic resyncs
+            animation_status.last_timer = rgblight_status.animation_start;
+            // A start more than a frame away means the sync arrived late, so pick
+            // up from now rather than rendering a burst of frames to catch up
+            int16_t late = (int16_t)TIMER_DIFF_16(sync_timer_read(), animation_status.last_timer);
+            if (late > (int16_t)interval_time || late < -(int16_t)interval_time) {
+                animation_status.last_timer = sync_timer_read();
+            }
+#    else
             animation_status.last_timer = sync_timer_read();
-            animation_status.pos16      = 0; // restart signal to local each effect
+#    endif
+            animation_status.pos16 = 0; // restart signal to local each effect
         }
         uint16_t now = sync_timer_read();
         if (timer_expired(now, animation_status.last_timer)) {
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
             static uint16_t report_last_timer = 0;
-            static bool     tick_flag         = false;
-            uint16_t        oldpos16;
-            if (tick_flag) {
-                tick_flag = false;
-                if (timer_expired(now, report_last_timer)) {
-                    report_last_timer += 30000;
-                    dprintf("rgblight animation tick report to slave\n");
-                    RGBLIGHT_SPLIT_ANIMATION_TICK;
-                }
-            }
-            oldpos16 = animation_status.pos16;
+            uint16_t        oldpos16          = animation_status.pos16;
 #    endif
             animation_status.last_timer += interval_time;
             effect_func(&animation_status);
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
-            if (animation_status.pos16 == 0 && oldpos16 != 0) {
-                tick_flag = true;
+            // At most every RGBLIGHT_SPLIT_ANIMATION_RESYNC_INTERVAL, when the
+            // animation wraps, restart the slave from the next frame
+            if (animation_status.pos16 == 0 && oldpos16 != 0 && timer_expired(now, report_last_timer)) {
+                report_last_timer               = now + RGBLIGHT_SPLIT_ANIMATION_RESYNC_INTERVAL;
+                rgblight_status.animation_start = animation_status.last_timer;
+                dprintf("rgblight animation tick report to slave\n");
+                RGBLIGHT_SPLIT_ANIMATION_TICK;
             }
 #    endif
         }
@@ -271,6 +271,9 @@ typedef struct _rgblight_status_t {
     bool    timer_enabled;
 #ifdef RGBLIGHT_SPLIT
     uint8_t change_flags;
+#    if defined(RGBLIGHT_USE_TIMER) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
+    uint16_t animation_start; // sync timer value the current animation started at
+#    endif
 #endif
 #ifdef RGBLIGHT_LAYERS
     rgblight_layer_mask_t enabled_layer_mask;
@@ -415,6 +418,11 @@ void rgblight_timer_toggle(void);
 #    define RGBLIGHT_STATUS_ANIMATION_TICK (1 << 3)
 #    define RGBLIGHT_STATUS_CHANGE_LAYERS (1 << 4)
 
+// how often, at most, the master restarts the slave's animation in step with its own
+#    ifndef RGBLIGHT_SPLIT_ANIMATION_RESYNC_INTERVAL
+#        define RGBLIGHT_SPLIT_ANIMATION_RESYNC_INTERVAL 30000
+#    endif
+
 typedef struct _rgblight_syncinfo_t {
     rgblight_config_t config;
     rgblight_status_t status;
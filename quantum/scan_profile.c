@@ -0,0 +1,75 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "scan_profile.h"
+#include "timer.h"
+
+#ifdef PROTOCOL_CHIBIOS
+#    include <hal.h>
+#endif
+
+static uint16_t scan_profile_histogram[SCAN_PROFILE_STAGE_COUNT][SCAN_PROFILE_BUCKETS];
+static uint32_t scan_profile_max[SCAN_PROFILE_STAGE_COUNT];
+
+#if defined(PROTOCOL_CHIBIOS) && (HAL_IMPLEMENTS_COUNTERS == TRUE)
+__attribute__((weak)) uint32_t scan_profile_now(void) {
+    return (uint32_t)halGetCounterValue();
+}
+
+__attribute__((weak)) uint32_t scan_profile_frequency(void) {
+    return (uint32_t)halGetCounterFrequency();
+}
+#else
+// No free-running counter available, fall back to the millisecond timer.
+__attribute__((weak)) uint32_t scan_profile_now(void) {
+    return timer_read32();
+}
+
+__attribute__((weak)) uint32_t scan_profile_frequency(void) {
+    return 1000;
+}
+#endif
+
+static uint8_t scan_profile_bucket(uint32_t ticks) {
+    uint8_t bucket = 0;
+    while (ticks && bucket < SCAN_PROFILE_BUCKETS - 1) {
+        ticks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void scan_profile_record(scan_profile_stage_t stage, uint32_t start) {
+    if (stage >= SCAN_PROFILE_STAGE_COUNT) {
+        return;
+    }
+
+    uint32_t  ticks = scan_profile_now() - start;
+    uint16_t *count = &scan_profile_histogram[stage][scan_profile_bucket(ticks)];
+    if (*count < UINT16_MAX) {
+        (*count)++;
+    }
+    if (ticks > scan_profile_max[stage]) {
+        scan_profile_max[stage] = ticks;
+    }
+}
+
+uint16_t scan_profile_get_bucket(scan_profile_stage_t stage, uint8_t bucket) {
+    if (stage >= SCAN_PROFILE_STAGE_COUNT || bucket >= SCAN_PROFILE_BUCKETS) {
+        return 0;
+    }
+    return scan_profile_histogram[stage][bucket];
+}
+
+uint32_t scan_profile_get_max(scan_profile_stage_t stage) {
+    if (stage >= SCAN_PROFILE_STAGE_COUNT) {
+        return 0;
+    }
+    return scan_profile_max[stage];
+}
+
+void scan_profile_reset(void) {
+    memset(scan_profile_histogram, 0, sizeof(scan_profile_histogram));
+    memset(scan_profile_max, 0, sizeof(scan_profile_max));
+}
@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+    Per-stage timing of the main scan loop, kept as log2 histograms in RAM.
+
+    Each stage records how long it took, in platform counter ticks, into
+    SCAN_PROFILE_BUCKETS buckets: bucket 0 holds zero-tick samples and bucket
+    n holds samples in [2^(n-1), 2^n). The last bucket also collects
+    everything longer. Counts saturate at 0xFFFF.
+
+    Usage:
+
+        SCAN_PROFILE_BEGIN(start);
+        do_work();
+        SCAN_PROFILE_END(SCAN_PROFILE_QUANTUM_TASK, start);
+
+    Both macros compile to nothing unless SCAN_PROFILE_ENABLE is set.
+*/
+
+#ifndef SCAN_PROFILE_BUCKETS
+#    define SCAN_PROFILE_BUCKETS 16
+#endif
+
+typedef enum {
+    SCAN_PROFILE_KEYBOARD_TASK,      // the whole of keyboard_task()
+    SCAN_PROFILE_MATRIX_SCAN,        // matrix_scan(), including debounce and split transactions
+    SCAN_PROFILE_DEBOUNCE,           // debounce()
+    SCAN_PROFILE_ACTION_EXEC,        // action_exec() for a key event
+    SCAN_PROFILE_QUANTUM_TASK,       // quantum_task()
+    SCAN_PROFILE_RGB_MATRIX_TASK,    // rgb_matrix_task()
+    SCAN_PROFILE_SPLIT_TRANSACTIONS, // master/slave matrix transport
+    SCAN_PROFILE_HOST_KEYBOARD_SEND, // host_keyboard_send()
+    SCAN_PROFILE_STAGE_COUNT,
+} scan_profile_stage_t;
+
+#ifdef SCAN_PROFILE_ENABLE
+
+/** \brief Returns the current value of the profiling counter */
+uint32_t scan_profile_now(void);
+
+/** \brief Returns the frequency of the profiling counter in Hz */
+uint32_t scan_profile_frequency(void);
+
+/** \brief Adds a sample for `stage` that started at `start` and ends now */
+void scan_profile_record(scan_profile_stage_t stage, uint32_t start);
+
+/** \brief Returns the sample count of one histogram bucket */
+uint16_t scan_profile_get_bucket(scan_profile_stage_t stage, uint8_t bucket);
+
+/** \brief Returns the longest sample seen for `stage`, in counter ticks */
+uint32_t scan_profile_get_max(scan_profile_stage_t stage);
+
+/** \brief Clears every histogram */
+void scan_profile_reset(void);
+
+#    define SCAN_PROFILE_BEGIN(name) uint32_t name = scan_profile_now()
+#    define SCAN_PROFILE_END(stage, name) scan_profile_record(stage, name)
+#else
+#    define SCAN_PROFILE_BEGIN(name)
+#    define SCAN_PROFILE_END(stage, name)
+#endif
@@ -213,6 +213,9 @@ void split_pre_init(void) {
 #endif
 
     if (is_keyboard_master()) {
+#ifdef SPLIT_EVENT_PIN
+        gpio_set_pin_input_high(SPLIT_EVENT_PIN);
+#endif
         transport_master_init();
     }
 }
@@ -222,6 +225,10 @@ void split_pre_init(void) {
 //     receiving before the init process has completed
 void split_post_init(void) {
     if (!is_keyboard_master()) {
+#ifdef SPLIT_EVENT_PIN
+        gpio_set_pin_output(SPLIT_EVENT_PIN);
+        gpio_write_pin_high(SPLIT_EVENT_PIN);
+#endif
         transport_slave_init();
 #if defined(SPLIT_WATCHDOG_ENABLE)
         split_watchdog_init();
@@ -229,6 +236,17 @@ void split_post_init(void) {
     }
 }
 
+#ifdef SPLIT_EVENT_PIN
+void split_event_signal(bool pending) {
+    // Active low, so an unconnected or unpowered slave never reads as an event
+    gpio_write_pin(SPLIT_EVENT_PIN, !pending);
+}
+
+bool split_event_pending(void) {
+    return !gpio_read_pin(SPLIT_EVENT_PIN);
+}
+#endif // SPLIT_EVENT_PIN
+
 bool is_transport_connected(void) {
     return connection_errors < SPLIT_MAX_CONNECTION_ERRORS;
 }
@@ -15,4 +15,11 @@ bool is_transport_connected(void);
 
 void split_watchdog_update(bool done);
 void split_watchdog_task(void);
-bool split_watchdog_check(void);
\ No newline at end of file
+bool split_watchdog_check(void);
+
+#ifdef SPLIT_EVENT_PIN
+// slave: drive the event line, asserted while there is state the master has not fetched
+void split_event_signal(bool pending);
+// master: whether the slave is asserting the event line
+bool split_event_pending(void);
+#endif
@@ -0,0 +1,14 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 4
+
+#define SPLIT_KEYBOARD
+#define SPLIT_TRANSACTION_BATCHED
+#define DISABLE_SYNC_TIMER
+
+#define RGBLIGHT_ENABLE
+#define RGBLIGHT_SPLIT
+#define RGBLIGHT_LED_COUNT 4
@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "mock_transport.h"
+#include "transactions.h"
+#include "transport.h"
+
+/*
+ * Both halves run in this one process. The shared memory always holds the
+ * master's view; the slave's view is swapped in for as long as it runs.
+ */
+static split_shared_memory_t shared_memory;
+static split_shared_memory_t slave_memory;
+static split_shared_memory_t master_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+
+rgblight_syncinfo_t mock_rgblight_master;
+rgblight_syncinfo_t mock_rgblight_applied[8];
+uint8_t             mock_rgblight_applied_count;
+uint8_t             mock_last_m2s_length;
+uint8_t             mock_last_s2m_length;
+
+static void become_slave(void) {
+    memcpy(&master_memory, &shared_memory, sizeof(split_shared_memory_t));
+    memcpy(&shared_memory, &slave_memory, sizeof(split_shared_memory_t));
+}
+
+static void become_master(void) {
+    memcpy(&slave_memory, &shared_memory, sizeof(split_shared_memory_t));
+    memcpy(&shared_memory, &master_memory, sizeof(split_shared_memory_t));
+}
+
+void mock_transport_reset(void) {
+    memset(&shared_memory, 0, sizeof(split_shared_memory_t));
+    memset(&slave_memory, 0, sizeof(split_shared_memory_t));
+    memset(&mock_rgblight_master, 0, sizeof(mock_rgblight_master));
+    mock_rgblight_applied_count = 0;
+    mock_last_m2s_length        = 0;
+    mock_last_s2m_length        = 0;
+}
+
+void mock_slave_scan(matrix_row_t slave_matrix[]) {
+    matrix_row_t master_matrix[MATRIX_ROWS / 2] = {0};
+    become_slave();
+    transactions_slave(master_matrix, slave_matrix);
+    become_master();
+}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    become_slave();
+    if (initiator2target_length) {
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, initiator2target_length);
+    }
+    if (trans->slave_callback) {
+        trans->slave_callback(initiator2target_length, split_trans_initiator2target_buffer(trans), target2initiator_length, split_trans_target2initiator_buffer(trans));
+    }
+    if (target2initiator_length) {
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), target2initiator_length);
+    }
+    if (id == EXCHANGE_BATCH) {
+        mock_last_m2s_length = ((const split_batch_m2s_t *)initiator2target_buf)->header.length;
+        mock_last_s2m_length = ((const split_batch_s2m_t *)target2initiator_buf)->header.length;
+    }
+    become_master();
+    return true;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+void rgblight_get_syncinfo(rgblight_syncinfo_t *syncinfo) {
+    memcpy(syncinfo, &mock_rgblight_master, sizeof(rgblight_syncinfo_t));
+}
+
+void rgblight_clear_change_flags(void) {
+    mock_rgblight_master.status.change_flags = 0;
+}
+
+void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
+    if (mock_rgblight_applied_count < sizeof(mock_rgblight_applied) / sizeof(mock_rgblight_applied[0])) {
+        memcpy(&mock_rgblight_applied[mock_rgblight_applied_count++], syncinfo, sizeof(rgblight_syncinfo_t));
+    }
+}
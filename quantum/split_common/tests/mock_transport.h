@@ -0,0 +1,24 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+#include "rgblight.h"
+
+// Master-side rgblight state, as handed to the split transport
+extern rgblight_syncinfo_t mock_rgblight_master;
+
+// Every rgblight update applied on the slave, most recent last
+extern rgblight_syncinfo_t mock_rgblight_applied[8];
+extern uint8_t             mock_rgblight_applied_count;
+
+// The number of data bytes in the most recent batch each way
+extern uint8_t mock_last_m2s_length;
+extern uint8_t mock_last_s2m_length;
+
+void mock_transport_reset(void);
+
+// Runs one scan of the slave half against its own copy of the shared memory
+void mock_slave_scan(matrix_row_t slave_matrix[]);
@@ -0,0 +1,12 @@
+split_batch_DEFS := -DEEPROM_TEST_HARNESS
+split_batch_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+split_batch_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(QUANTUM_PATH)/rgblight
+
+split_batch_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_batch_tests.cpp
@@ -0,0 +1,109 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#define _Static_assert static_assert
+
+extern "C" {
+#include "transactions.h"
+#include "split_common/tests/mock_transport.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif
+
+class SplitBatch : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[MATRIX_ROWS / 2] = {0};
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2]  = {0};
+    matrix_row_t slave_keys[MATRIX_ROWS / 2]    = {0};
+
+    void SetUp() override {
+        // The transport keeps its own timestamps, so time has to keep moving forwards from one test to the next
+        static uint32_t epoch = 0;
+        epoch += 0x100000;
+        set_time(epoch);
+        mock_slave_scan(slave_keys);
+        scan();
+        scan();
+        mock_rgblight_applied_count = 0;
+    }
+
+    // One scan of each half, the master first, as both would run on a keyboard
+    void scan() {
+        transactions_master(master_matrix, slave_matrix);
+        mock_slave_scan(slave_keys);
+    }
+};
+
+TEST_F(SplitBatch, RgblightChangeReachesSlave) {
+    mock_rgblight_master.config.mode         = 7;
+    mock_rgblight_master.status.change_flags = RGBLIGHT_STATUS_CHANGE_MODE;
+
+    // Queued by the first scan, carried by the batch at the start of the second
+    scan();
+    scan();
+    ASSERT_EQ(mock_rgblight_applied_count, 1);
+    EXPECT_EQ(mock_rgblight_applied[0].status.change_flags, RGBLIGHT_STATUS_CHANGE_MODE);
+    EXPECT_EQ(mock_rgblight_applied[0].config.mode, 7);
+}
+
+TEST_F(SplitBatch, ResyncDoesNotReapplyDeliveredChange) {
+    mock_rgblight_master.config.mode         = 9;
+    mock_rgblight_master.status.change_flags = RGBLIGHT_STATUS_CHANGE_MODE;
+    scan();
+    scan();
+    ASSERT_EQ(mock_rgblight_applied_count, 1);
+
+    for (int i = 0; i < 3; i++) {
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        scan();
+        EXPECT_GT(mock_last_m2s_length, 0) << "Resync did not resend the master's state";
+        scan();
+    }
+    EXPECT_EQ(mock_rgblight_applied_count, 1);
+}
+
+TEST_F(SplitBatch, ChangeQueuedBeforeResyncKeepsItsFlags) {
+    mock_rgblight_master.config.mode         = 11;
+    mock_rgblight_master.status.change_flags = RGBLIGHT_STATUS_CHANGE_MODE | RGBLIGHT_STATUS_CHANGE_HSVS;
+    scan();
+    // The batch carrying the change is also a resync, which resends every region in full
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    scan();
+    ASSERT_EQ(mock_rgblight_applied_count, 1);
+    EXPECT_EQ(mock_rgblight_applied[0].status.change_flags, RGBLIGHT_STATUS_CHANGE_MODE | RGBLIGHT_STATUS_CHANGE_HSVS);
+}
+
+TEST_F(SplitBatch, RepeatedChangeIsDeliveredAgain) {
+    for (int i = 0; i < 2; i++) {
+        mock_rgblight_master.status.change_flags = RGBLIGHT_STATUS_CHANGE_HSVS;
+        scan();
+        scan();
+    }
+    ASSERT_EQ(mock_rgblight_applied_count, 2);
+    EXPECT_EQ(mock_rgblight_applied[1].status.change_flags, RGBLIGHT_STATUS_CHANGE_HSVS);
+}
+
+TEST_F(SplitBatch, SlaveMatrixIsOnlySentWhenChanged) {
+    slave_keys[1] = 0b101;
+    scan();
+    scan();
+    EXPECT_GT(mock_last_s2m_length, 0);
+    EXPECT_EQ(slave_matrix[1], 0b101);
+
+    // Once the master has acknowledged the change there is nothing left to send
+    scan();
+    EXPECT_EQ(mock_last_s2m_length, 0);
+    EXPECT_EQ(slave_matrix[1], 0b101);
+
+    slave_keys[1] = 0;
+    scan();
+    scan();
+    EXPECT_GT(mock_last_s2m_length, 0);
+    EXPECT_EQ(slave_matrix[1], 0);
+}
@@ -97,6 +97,10 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#ifdef SPLIT_TRANSACTION_BATCHED
+    EXCHANGE_BATCH,
+#endif // SPLIT_TRANSACTION_BATCHED
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
@@ -88,12 +88,80 @@
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
 
+#ifdef SPLIT_TRANSACTION_BATCHED
+static bool split_batch_put(int8_t trans_id, const void *data, size_t length);
+// State updates are queued into the next batch rather than sent immediately
+#    define transport_put(id, data, length) split_batch_put(id, data, length)
+#else // SPLIT_TRANSACTION_BATCHED
+#    define transport_put(id, data, length) transport_write(id, data, length)
+#endif // SPLIT_TRANSACTION_BATCHED
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+////////////////////////////////////////////////////
+// Slave events
+
+#ifdef SPLIT_EVENT_PIN
+
+#    ifndef SPLIT_EVENT_KEEPALIVE_MS
+#        define SPLIT_EVENT_KEEPALIVE_MS FORCED_SYNC_THROTTLE_MS
+#    endif // SPLIT_EVENT_KEEPALIVE_MS
+
+static bool    split_event_fetch         = true; // master: whether this scan reads the slave's state
+static uint8_t split_event_fetched_state = 0;    // slave: state as of the master's last read
+
+static bool split_event_poll(void) {
+    static uint32_t last_fetch = 0;
+    if (split_event_pending() || timer_elapsed32(last_fetch) >= SPLIT_EVENT_KEEPALIVE_MS) {
+        last_fetch = timer_read32();
+        return true;
+    }
+    return false;
+}
+
+static uint8_t split_event_state(void) {
+    // Everything the master reads from the slave is covered by one of these checksums
+    uint8_t checksums[] = {
+        split_shmem->smatrix.checksum,
+#    ifdef ENCODER_ENABLE
+        split_shmem->encoders.checksum,
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        split_shmem->pointing.checksum,
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    };
+    return crc8(checksums, sizeof(checksums));
+}
+
+static void split_event_fetched(void) {
+    split_event_fetched_state = split_event_state();
+    split_event_signal(false);
+}
+
+static void split_event_fetched_cb(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_event_fetched();
+}
+
+static void split_event_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_event_signal(split_event_state() != split_event_fetched_state);
+}
+
+#    define TRANSACTIONS_SPLIT_EVENT_MASTER() split_event_fetch = split_event_poll()
+#    define TRANSACTIONS_SPLIT_EVENT_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(split_event)
+#    define SPLIT_EVENT_FETCHED_CB split_event_fetched_cb
+
+#else // SPLIT_EVENT_PIN
+
+#    define TRANSACTIONS_SPLIT_EVENT_MASTER()
+#    define TRANSACTIONS_SPLIT_EVENT_SLAVE()
+#    define SPLIT_EVENT_FETCHED_CB NULL
+
+#endif // SPLIT_EVENT_PIN
+
 ////////////////////////////////////////////////////
 // Helpers
 
@@ -145,6 +213,19 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     } while (0)
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+#ifdef SPLIT_TRANSACTION_BATCHED
+    // The batch exchange at the start of the scan has already brought the slave's data into shared memory
+    uint8_t curr_checksum = *split_trans_target2initiator_buffer(&split_transaction_table[trans_id_checksum]);
+    memcpy(destination, equiv_shmem, length);
+    return curr_checksum == crc8(equiv_shmem, length);
+#else  // SPLIT_TRANSACTION_BATCHED
+#    ifdef SPLIT_EVENT_PIN
+    // Nothing has changed on the slave since the last read
+    if (!split_event_fetch) {
+        memcpy(destination, equiv_shmem, length);
+        return true;
+    }
+#    endif // SPLIT_EVENT_PIN
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
@@ -157,12 +238,13 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
         memcpy(destination, equiv_shmem, length);
     }
     return okay;
+#endif // SPLIT_TRANSACTION_BATCHED
 }
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
-        okay &= transport_write(trans_id, source, length);
+        okay &= transport_put(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
         }
@@ -175,6 +257,334 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Batched transport
+
+#ifdef SPLIT_TRANSACTION_BATCHED
+
+#    define SPLIT_BATCH_BITMAP_SIZE ((NUM_TOTAL_TRANSACTIONS + 7) / 8)
+#    define split_batch_bit_get(bitmap, id) (((bitmap)[(id) / 8] & (1 << ((id) % 8))) != 0)
+#    define split_batch_bit_set(bitmap, id) ((bitmap)[(id) / 8] |= (1 << ((id) % 8)))
+#    define split_batch_bit_clear(bitmap, id) ((bitmap)[(id) / 8] &= ~(1 << ((id) % 8)))
+
+static uint8_t  split_batch_known[SPLIT_BATCH_BITMAP_SIZE];      // regions ever written by the master
+static uint8_t  split_batch_dirty[SPLIT_BATCH_BITMAP_SIZE];      // regions with bytes the slave may not have yet
+static uint8_t  split_batch_dirty_start[NUM_TOTAL_TRANSACTIONS]; // first dirty byte of each region
+static uint8_t  split_batch_dirty_end[NUM_TOTAL_TRANSACTIONS];   // one past the last dirty byte of each region
+static uint8_t  split_batch_included[SPLIT_BATCH_BITMAP_SIZE];   // regions carried by the batch being exchanged
+static uint32_t split_batch_last_resync    = 0;
+static bool     split_batch_resync_pending = false;
+static bool     split_batch_ack_valid      = false;
+static uint8_t  split_batch_ack_seq        = 0;
+#    ifdef SPLIT_TRANSPORT_ASYNC
+static bool split_batch_in_flight = false;
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+static uint8_t split_batch_checksum(const split_batch_header_t *header) {
+    // Covers flags, seq, length and the data that follows the header
+    return crc8(&header->flags, sizeof(split_batch_header_t) - sizeof(header->checksum) + header->length);
+}
+
+static void split_batch_mark_dirty(int8_t trans_id, uint8_t start, uint8_t end) {
+    // A change made while its region is on the wire must survive that batch being acknowledged
+    split_batch_bit_clear(split_batch_included, trans_id);
+    if (split_batch_bit_get(split_batch_dirty, trans_id)) {
+        if (start < split_batch_dirty_start[trans_id]) split_batch_dirty_start[trans_id] = start;
+        if (end > split_batch_dirty_end[trans_id]) split_batch_dirty_end[trans_id] = end;
+    } else {
+        split_batch_bit_set(split_batch_dirty, trans_id);
+        split_batch_dirty_start[trans_id] = start;
+        split_batch_dirty_end[trans_id]   = end;
+    }
+}
+
+static bool split_batch_put(int8_t trans_id, const void *data, size_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[trans_id];
+    if (length > trans->initiator2target_buffer_size) {
+        length = trans->initiator2target_buffer_size;
+    }
+    if (length > SPLIT_BATCH_BUFFER_SIZE - SPLIT_BATCH_RECORD_HEADER) {
+        // Can never fit in a batch, fall back to a dedicated round trip
+        return transport_write(trans_id, data, length);
+    }
+
+    // Only the span of bytes that differ from the last value put needs to travel
+    const uint8_t *source = (const uint8_t *)data;
+    uint8_t       *shmem  = split_trans_initiator2target_buffer(trans);
+    uint8_t        start  = 0;
+    uint8_t        end    = length;
+    while (start < end && source[start] == shmem[start]) {
+        ++start;
+    }
+    while (end > start && source[end - 1] == shmem[end - 1]) {
+        --end;
+    }
+
+    memcpy(shmem, source, length);
+    split_batch_bit_set(split_batch_known, trans_id);
+    if (start < end) {
+        split_batch_mark_dirty(trans_id, start, end);
+    }
+    return true;
+}
+
+static bool split_batch_append(uint8_t *data, uint8_t capacity, uint8_t *length, int8_t trans_id, uint8_t offset, uint8_t count, const uint8_t *source) {
+    if (*length + SPLIT_BATCH_RECORD_HEADER + count > capacity) {
+        return false;
+    }
+    uint8_t *record = &data[*length];
+    record[0]       = trans_id;
+    record[1]       = offset;
+    record[2]       = count;
+    memcpy(&record[SPLIT_BATCH_RECORD_HEADER], source, count);
+    *length += SPLIT_BATCH_RECORD_HEADER + count;
+    return true;
+}
+
+/**
+ * @brief Writes every record of a batch into the matching regions of `base`,
+ * which is laid out as split_shared_memory_t. Records are absolute writes, so
+ * applying the same batch more than once is harmless.
+ */
+static bool split_batch_apply(const uint8_t *data, uint8_t length, bool target2initiator, uint8_t *base) {
+    uint8_t pos = 0;
+    while (pos + SPLIT_BATCH_RECORD_HEADER <= length) {
+        uint8_t trans_id = data[pos];
+        uint8_t offset   = data[pos + 1];
+        uint8_t count    = data[pos + 2];
+        pos += SPLIT_BATCH_RECORD_HEADER;
+        if (trans_id >= NUM_TOTAL_TRANSACTIONS || pos + count > length) {
+            return false;
+        }
+
+        split_transaction_desc_t *trans       = &split_transaction_table[trans_id];
+        uint8_t                   region_size = target2initiator ? trans->target2initiator_buffer_size : trans->initiator2target_buffer_size;
+        uint16_t                  region      = target2initiator ? trans->target2initiator_offset : trans->initiator2target_offset;
+        if (offset + count > region_size) {
+            return false;
+        }
+        memcpy(base + region + offset, &data[pos], count);
+        pos += count;
+    }
+    return pos == length;
+}
+
+static void split_batch_encode(split_batch_m2s_t *request) {
+    if (timer_elapsed32(split_batch_last_resync) >= FORCED_SYNC_THROTTLE_MS) {
+        split_batch_last_resync    = timer_read32();
+        split_batch_resync_pending = true;
+        // Resend everything in full, in case the slave has restarted since
+        for (int8_t i = 0; i < NUM_TOTAL_TRANSACTIONS; ++i) {
+            if (split_batch_bit_get(split_batch_known, i)) {
+                split_batch_mark_dirty(i, 0, split_transaction_table[i].initiator2target_buffer_size);
+            }
+        }
+#    ifndef DISABLE_SYNC_TIMER
+        uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
+        split_batch_put(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
+#    endif // DISABLE_SYNC_TIMER
+    }
+
+    memset(request, 0, sizeof(split_batch_m2s_t));
+    memset(split_batch_included, 0, sizeof(split_batch_included));
+    if (split_batch_ack_valid) {
+        request->header.flags |= SPLIT_BATCH_FLAG_ACK;
+        request->header.seq = split_batch_ack_seq;
+    }
+    if (split_batch_resync_pending) {
+        request->header.flags |= SPLIT_BATCH_FLAG_RESYNC;
+    }
+    for (int8_t i = 0; i < NUM_TOTAL_TRANSACTIONS; ++i) {
+        if (split_batch_bit_get(split_batch_dirty, i)) {
+            uint8_t start = split_batch_dirty_start[i];
+            uint8_t count = split_batch_dirty_end[i] - start;
+            // Anything that doesn't fit stays dirty for the next scan
+            if (split_batch_append(request->data, sizeof(request->data), &request->header.length, i, start, count, split_trans_initiator2target_buffer(&split_transaction_table[i]) + start)) {
+                split_batch_bit_set(split_batch_included, i);
+            }
+        }
+    }
+    request->header.checksum = split_batch_checksum(&request->header);
+    split_batch_ack_valid    = false;
+}
+
+static bool split_batch_decode(const split_batch_s2m_t *response) {
+    if (response->header.length > sizeof(response->data) || response->header.checksum != split_batch_checksum(&response->header) || (response->header.flags & SPLIT_BATCH_FLAG_NAK)) {
+        // Delivery is unknown, so everything stays dirty and will be rewritten
+        return false;
+    }
+
+    for (int8_t i = 0; i < NUM_TOTAL_TRANSACTIONS; ++i) {
+        if (split_batch_bit_get(split_batch_included, i)) {
+            split_batch_bit_clear(split_batch_dirty, i);
+        }
+    }
+    split_batch_resync_pending = false;
+
+    split_shared_memory_lock();
+    bool okay = split_batch_apply(response->data, response->header.length, true, (uint8_t *)split_shmem);
+    split_shared_memory_unlock();
+    if (okay) {
+        split_batch_ack_valid = true;
+        split_batch_ack_seq   = response->header.seq;
+    }
+    return okay;
+}
+
+static inline bool split_batch_pending(int8_t trans_id) {
+    return split_batch_bit_get(split_batch_dirty, trans_id);
+}
+
+static bool split_batch_needed(void) {
+#    ifdef SPLIT_EVENT_PIN
+    // Stay off the wire unless the slave has news, there is something to send or a resync is due
+    if (split_event_fetch || timer_elapsed32(split_batch_last_resync) >= FORCED_SYNC_THROTTLE_MS) {
+        return true;
+    }
+    for (uint8_t i = 0; i < SPLIT_BATCH_BITMAP_SIZE; ++i) {
+        if (split_batch_dirty[i]) {
+            return true;
+        }
+    }
+    return false;
+#    else  // SPLIT_EVENT_PIN
+    return true;
+#    endif // SPLIT_EVENT_PIN
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_m2s_t request;
+    split_batch_s2m_t response;
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    // Collect the exchange started at the end of the previous scan, falling back to a blocking one if it failed
+    if (split_batch_in_flight) {
+        split_batch_in_flight = false;
+        if (transport_finish_transaction(EXCHANGE_BATCH, &response, sizeof(response)) && split_batch_decode(&response)) {
+            return true;
+        }
+    }
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+    if (!split_batch_needed()) {
+        return true;
+    }
+    split_batch_encode(&request);
+    return transport_execute_transaction(EXCHANGE_BATCH, &request, sizeof(request), &response, sizeof(response)) && split_batch_decode(&response);
+}
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+static void batch_start_master(void) {
+    split_batch_m2s_t request;
+#        ifdef SPLIT_EVENT_PIN
+    split_event_fetch = split_event_poll();
+#        endif // SPLIT_EVENT_PIN
+    if (!split_batch_needed()) {
+        return;
+    }
+    split_batch_encode(&request);
+    transport_start_transaction(EXCHANGE_BATCH, &request, sizeof(request));
+    split_batch_in_flight = true;
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+static bool split_batch_s2m_region(int8_t trans_id) {
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (trans_id == GET_RPC_RESP_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return trans_id != EXCHANGE_BATCH && split_transaction_table[trans_id].target2initiator_buffer_size != 0;
+}
+
+/**
+ * @brief Copies the records of an acknowledged slave batch into `acked`, which
+ * holds the slave-to-master regions back to back in transaction order. The
+ * records were written by the slave itself in that same order.
+ */
+static void split_batch_acknowledge(const split_batch_s2m_t *response, uint8_t *acked) {
+    uint8_t pos  = 0;
+    uint8_t base = 0;
+    for (int8_t i = 0; i < NUM_TOTAL_TRANSACTIONS && pos + SPLIT_BATCH_RECORD_HEADER <= response->header.length; ++i) {
+        if (!split_batch_s2m_region(i)) continue;
+        const uint8_t *record = &response->data[pos];
+        if (record[0] == i) {
+            memcpy(acked + base + record[1], &record[SPLIT_BATCH_RECORD_HEADER], record[2]);
+            pos += SPLIT_BATCH_RECORD_HEADER + record[2];
+        }
+        base += split_transaction_table[i].target2initiator_buffer_size;
+    }
+}
+
+static void batch_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // The slave-to-master regions as last acknowledged by the master, used as the delta baseline.
+    // A response holds every one of them at once, so its size also bounds theirs.
+    static uint8_t acked[SPLIT_BATCH_S2M_SIZE];
+    static uint8_t forced[SPLIT_BATCH_BITMAP_SIZE];
+    static uint8_t seq = 0;
+
+    const split_batch_m2s_t *request  = (const split_batch_m2s_t *)initiator2target_buffer;
+    split_batch_s2m_t       *response = (split_batch_s2m_t *)target2initiator_buffer;
+
+    if (request->header.length > sizeof(request->data) || request->header.checksum != split_batch_checksum(&request->header)) {
+        response->header.flags  = SPLIT_BATCH_FLAG_NAK;
+        response->header.length = 0;
+    } else {
+        // The previous response is still in the buffer; once acknowledged it becomes the new baseline
+        if ((request->header.flags & SPLIT_BATCH_FLAG_ACK) && request->header.seq == seq) {
+            split_batch_acknowledge(response, acked);
+        }
+        if (request->header.flags & SPLIT_BATCH_FLAG_RESYNC) {
+            memset(forced, 0xFF, sizeof(forced));
+        }
+        split_batch_apply(request->data, request->header.length, false, (uint8_t *)split_shmem);
+
+        response->header.flags  = 0;
+        response->header.seq    = ++seq;
+        response->header.length = 0;
+        uint8_t base            = 0;
+        for (int8_t i = 0; i < NUM_TOTAL_TRANSACTIONS; ++i) {
+            if (!split_batch_s2m_region(i)) continue;
+
+            split_transaction_desc_t *trans   = &split_transaction_table[i];
+            const uint8_t            *current = split_trans_target2initiator_buffer(trans);
+            const uint8_t            *known   = &acked[base];
+            uint8_t                   start   = 0;
+            uint8_t                   end     = trans->target2initiator_buffer_size;
+            base += trans->target2initiator_buffer_size;
+            if (!split_batch_bit_get(forced, i)) {
+                while (start < end && current[start] == known[start]) {
+                    ++start;
+                }
+                while (end > start && current[end - 1] == known[end - 1]) {
+                    --end;
+                }
+            }
+            if (start == end || split_batch_append(response->data, sizeof(response->data), &response->header.length, i, start, end - start, current + start)) {
+                split_batch_bit_clear(forced, i);
+            }
+        }
+    }
+    response->header.checksum = split_batch_checksum(&response->header);
+#    ifdef SPLIT_EVENT_PIN
+    split_event_fetched();
+#    endif // SPLIT_EVENT_PIN
+}
+
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    ifdef SPLIT_TRANSPORT_ASYNC
+#        define TRANSACTIONS_BATCH_START_MASTER() batch_start_master()
+#    else // SPLIT_TRANSPORT_ASYNC
+#        define TRANSACTIONS_BATCH_START_MASTER()
+#    endif // SPLIT_TRANSPORT_ASYNC
+#    define TRANSACTIONS_BATCH_REGISTRATIONS [EXCHANGE_BATCH] = {sizeof_member(split_shared_memory_t, batch_m2s), offsetof(split_shared_memory_t, batch_m2s), sizeof_member(split_shared_memory_t, batch_s2m), offsetof(split_shared_memory_t, batch_s2m), batch_handlers_slave},
+
+#else // SPLIT_TRANSACTION_BATCHED
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_START_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCHED
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
@@ -202,7 +612,7 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
-    [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
+    [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer_cb(smatrix.checksum, SPLIT_EVENT_FETCHED_CB), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
@@ -249,7 +659,7 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
             bool    actioned = false;
             uint8_t index;
             bool    clockwise;
-            while (okay && encoder_dequeue_event_advanced(&split_shmem->encoders.events, &index, &clockwise)) {
+            while (okay && encoder_dequeue_event_advanced(&temp_events, &index, &clockwise)) {
                 okay &= encoder_queue_event(index, clockwise);
                 actioned = true;
             }
@@ -318,7 +728,12 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     }
 }
 
-#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer)
+#    ifdef SPLIT_TRANSACTION_BATCHED
+// The batch encoder stamps the sync timer itself, right before the exchange
+#        define TRANSACTIONS_SYNC_TIMER_MASTER()
+#    else // SPLIT_TRANSACTION_BATCHED
+#        define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer)
+#    endif // SPLIT_TRANSACTION_BATCHED
 #    define TRANSACTIONS_SYNC_TIMER_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(sync_timer)
 #    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_initiator2target_initializer(sync_timer),
 
@@ -423,7 +838,7 @@ static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slav
 
     bool okay = true;
     if (mods_need_sync) {
-        okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
+        okay &= transport_put(PUT_MODS, &new_mods, sizeof(new_mods));
         if (okay) {
             last_update = timer_read32();
         }
@@ -497,6 +912,13 @@ static bool rgblight_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     static uint32_t     last_update = 0;
     rgblight_syncinfo_t rgblight_sync;
     rgblight_get_syncinfo(&rgblight_sync);
+#    ifdef SPLIT_TRANSACTION_BATCHED
+    // The slave clears the flags once consumed. Mirror that so the next change is seen as a delta, but only once the
+    // batch carrying them has been acknowledged, as the batch is built from shared memory after this handler has run.
+    if (!split_batch_pending(PUT_RGBLIGHT)) {
+        split_shmem->rgblight_sync.status.change_flags = 0;
+    }
+#    endif // SPLIT_TRANSACTION_BATCHED
     if (send_if_condition(PUT_RGBLIGHT, &last_update, (rgblight_sync.status.change_flags != 0), &rgblight_sync, sizeof(rgblight_sync))) {
         rgblight_clear_change_flags();
     } else {
@@ -718,8 +1140,7 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     if (okay) pointing_device_set_shared_report(temp_state);
     temp_cpi = pointing_device_get_shared_cpi();
     if (temp_cpi && last_cpi != temp_cpi) {
-        split_shmem->pointing.cpi = temp_cpi;
-        okay                      = transport_write(PUT_POINTING_CPI, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
+        okay = transport_put(PUT_POINTING_CPI, &temp_cpi, sizeof(temp_cpi));
         if (okay) {
             last_cpi = temp_cpi;
         }
@@ -787,7 +1208,7 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 static bool watchdog_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     bool okay = true;
     if (!split_watchdog_check()) {
-        okay = transport_write(PUT_WATCHDOG, &okay, sizeof(okay));
+        okay = transport_put(PUT_WATCHDOG, &okay, sizeof(okay));
         split_watchdog_update(okay);
     }
     return okay;
@@ -938,6 +1359,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -949,6 +1371,8 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_SPLIT_EVENT_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -968,6 +1392,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_BATCH_START_MASTER();
     return true;
 }
 
@@ -991,6 +1416,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_SPLIT_EVENT_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
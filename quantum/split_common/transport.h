@@ -40,6 +40,20 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+#    if defined(USE_I2C) || !defined(PROTOCOL_CHIBIOS) || !(defined(SERIAL_DRIVER_USART) || defined(SERIAL_DRIVER_VENDOR))
+#        error "SPLIT_TRANSPORT_ASYNC requires the ChibiOS usart or vendor serial driver"
+#    endif
+#    ifndef SPLIT_TRANSACTION_BATCHED
+#        error "SPLIT_TRANSPORT_ASYNC requires SPLIT_TRANSACTION_BATCHED"
+#    endif
+
+// starts a transaction and returns immediately, the target2initiator buffer is filled in by transport_finish_transaction
+void transport_start_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+// waits for the transaction started by transport_start_transaction, returns false if it failed
+bool transport_finish_transaction(int8_t id, void *target2initiator_buf, uint16_t target2initiator_length);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -146,6 +160,53 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCHED
+#    ifndef SPLIT_BATCH_BUFFER_SIZE
+#        define SPLIT_BATCH_BUFFER_SIZE 32
+#    endif // SPLIT_BATCH_BUFFER_SIZE
+
+// Each record in a batch is [transaction id][offset][length][bytes...]
+#    define SPLIT_BATCH_RECORD_HEADER 3
+
+// The slave-to-master batch is sized to always hold every region at once, so
+// that a checksum and the data it covers can never arrive in separate scans.
+#    define SPLIT_BATCH_S2M_SMATRIX_SIZE (2 * SPLIT_BATCH_RECORD_HEADER + sizeof(split_slave_matrix_sync_t))
+#    ifdef ENCODER_ENABLE
+#        define SPLIT_BATCH_S2M_ENCODERS_SIZE (2 * SPLIT_BATCH_RECORD_HEADER + sizeof(split_slave_encoder_sync_t))
+#    else
+#        define SPLIT_BATCH_S2M_ENCODERS_SIZE 0
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#        define SPLIT_BATCH_S2M_POINTING_SIZE (2 * SPLIT_BATCH_RECORD_HEADER + sizeof(split_slave_pointing_sync_t))
+#    else
+#        define SPLIT_BATCH_S2M_POINTING_SIZE 0
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    define SPLIT_BATCH_S2M_SIZE (SPLIT_BATCH_S2M_SMATRIX_SIZE + SPLIT_BATCH_S2M_ENCODERS_SIZE + SPLIT_BATCH_S2M_POINTING_SIZE)
+
+enum split_batch_flags {
+    SPLIT_BATCH_FLAG_ACK    = (1 << 0), // master received the slave batch numbered `seq`
+    SPLIT_BATCH_FLAG_RESYNC = (1 << 1), // master requests every slave region in full
+    SPLIT_BATCH_FLAG_NAK    = (1 << 2), // slave rejected a corrupt master batch
+};
+
+typedef struct _split_batch_header_t {
+    uint8_t checksum; // crc8 of everything after this field, up to `length` bytes of data
+    uint8_t flags;
+    uint8_t seq;
+    uint8_t length;
+} split_batch_header_t;
+
+typedef struct _split_batch_m2s_t {
+    split_batch_header_t header;
+    uint8_t              data[SPLIT_BATCH_BUFFER_SIZE];
+} split_batch_m2s_t;
+
+typedef struct _split_batch_s2m_t {
+    split_batch_header_t header;
+    uint8_t              data[SPLIT_BATCH_S2M_SIZE];
+} split_batch_s2m_t;
+#endif // SPLIT_TRANSACTION_BATCHED
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -230,6 +291,11 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSACTION_BATCHED
+    split_batch_m2s_t batch_m2s;
+    split_batch_s2m_t batch_s2m;
+#endif // SPLIT_TRANSACTION_BATCHED
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
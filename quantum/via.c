@@ -192,6 +192,55 @@ bool process_record_via(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
+#ifdef SCAN_PROFILE_ENABLE
+// Request:  [0] id_scan_profile, [1] stage (0xFF for the layout), [2] first bucket
+// Layout:   [2] stage count, [3] bucket count, [4..7] counter frequency in Hz
+// Stage:    [3..6] longest sample in ticks, [7..] bucket counts from the first bucket
+// All multi-byte values are big-endian.
+static void via_scan_profile_get(uint8_t *data, uint8_t length) {
+    if (data[1] == 0xFF) {
+        uint32_t frequency = scan_profile_frequency();
+        data[2]            = SCAN_PROFILE_STAGE_COUNT;
+        data[3]            = SCAN_PROFILE_BUCKETS;
+        data[4]            = (frequency >> 24) & 0xFF;
+        data[5]            = (frequency >> 16) & 0xFF;
+        data[6]            = (frequency >> 8) & 0xFF;
+        data[7]            = frequency & 0xFF;
+        return;
+    }
+
+    scan_profile_stage_t stage = data[1];
+    uint32_t             max   = scan_profile_get_max(stage);
+    data[3]                    = (max >> 24) & 0xFF;
+    data[4]                    = (max >> 16) & 0xFF;
+    data[5]                    = (max >> 8) & 0xFF;
+    data[6]                    = max & 0xFF;
+    for (uint8_t i = 7, bucket = data[2]; i + 1 < length; i += 2, bucket++) {
+        uint16_t count = scan_profile_get_bucket(stage, bucket);
+        data[i]        = count >> 8;
+        data[i + 1]    = count & 0xFF;
+    }
+}
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+// Request:  [0] id_latency_trace, [1] stage
+// Response: [2..5] count, [6..9] min, [10..13] average, [14..17] p99, [18..21] max
+// Durations are in microseconds, all values are big-endian.
+static void via_latency_trace_get(uint8_t *data) {
+    latency_trace_summary_t summary;
+    latency_trace_get_summary(data[1], &summary);
+
+    uint32_t values[] = {summary.count, summary.min, summary.avg, summary.p99, summary.max};
+    for (uint8_t i = 0; i < ARRAY_SIZE(values); i++) {
+        data[2 + i * 4] = (values[i] >> 24) & 0xFF;
+        data[3 + i * 4] = (values[i] >> 16) & 0xFF;
+        data[4 + i * 4] = (values[i] >> 8) & 0xFF;
+        data[5 + i * 4] = values[i] & 0xFF;
+    }
+}
+#endif
+
 // Keyboard level code can override this to handle custom messages from VIA.
 // See raw_hid_receive() implementation.
 // DO NOT call raw_hid_send() in the override function.
@@ -271,6 +320,18 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 #endif
                     break;
                 }
+#ifdef SCAN_PROFILE_ENABLE
+                case id_scan_profile: {
+                    via_scan_profile_get(command_data, length - 1);
+                    break;
+                }
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+                case id_latency_trace: {
+                    via_latency_trace_get(command_data);
+                    break;
+                }
+#endif
                 default: {
                     raw_hid_receive_kb(data, length);
                     break;
@@ -285,6 +346,18 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     via_set_layout_options(value);
                     break;
                 }
+#ifdef SCAN_PROFILE_ENABLE
+                case id_scan_profile: {
+                    scan_profile_reset();
+                    break;
+                }
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+                case id_latency_trace: {
+                    latency_trace_reset();
+                    break;
+                }
+#endif
                 default: {
                     raw_hid_receive_kb(data, length);
                     break;
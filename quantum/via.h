@@ -104,6 +104,8 @@ enum via_keyboard_value_id {
     id_switch_matrix_state = 0x03,
     id_firmware_version    = 0x04,
     id_device_indication   = 0x05,
+    id_scan_profile        = 0x06,
+    id_latency_trace       = 0x07,
 };
 
 enum via_channel_id {
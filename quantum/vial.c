@@ -525,6 +525,10 @@ static void reload_combo(void) {
             key_combos[i].keycode = entry.output;
         }
     }
+
+#ifdef COMBO_INDEXED
+    combo_index_rebuild();
+#endif
 }
 #endif
 
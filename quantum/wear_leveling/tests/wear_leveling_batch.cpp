@@ -0,0 +1,171 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingBatch : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+static constexpr std::size_t extent_backing_writes(std::size_t length) {
+    return (sizeof(write_log_entry_t) + length + BACKING_STORE_WRITE_SIZE - 1) / BACKING_STORE_WRITE_SIZE;
+}
+
+/**
+ * This test verifies that writes inside a batch only reach the backing store on commit, as a single extent.
+ */
+TEST_F(WearLevelingBatch, CommitWritesSingleExtent) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::array<std::uint8_t, 64> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+
+    EXPECT_EQ(wear_leveling_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    for (std::size_t i = 0; i < testvalue.size(); i += 2) {
+        EXPECT_EQ(wear_leveling_write(0x40 + i, &testvalue[i], 2), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Batched writes should not reach the backing store before commit";
+
+    std::array<std::uint8_t, 64> readback;
+    EXPECT_EQ(wear_leveling_read(0x40, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, testvalue) << "Batched writes should be visible to reads before commit";
+
+    EXPECT_EQ(wear_leveling_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), extent_backing_writes(testvalue.size())) << "Commit should have written a single extent";
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_LOGICAL_SIZE + 8) << "Extent should start the write log";
+
+    // Play back the write log from scratch
+    readback.fill(0);
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0x40, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, testvalue) << "Invalid readback after playback";
+}
+
+/**
+ * This test verifies that separate runs of changes in a batch become separate extents, and that nested batches only commit once.
+ */
+TEST_F(WearLevelingBatch, NestedCommitWritesRuns) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t a = 0x11, b = 0x22;
+    wear_leveling_begin();
+    wear_leveling_begin();
+    wear_leveling_write(0x03, &a, sizeof(a));
+    wear_leveling_write(0x83, &b, sizeof(b));
+    EXPECT_EQ(wear_leveling_commit(), WEAR_LEVELING_SUCCESS) << "Inner commit returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Inner commit should not reach the backing store";
+    EXPECT_EQ(wear_leveling_commit(), WEAR_LEVELING_SUCCESS) << "Outer commit returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 2 * extent_backing_writes(WEAR_LEVELING_BATCH_GRANULARITY)) << "Commit should have written two extents";
+    EXPECT_EQ(wear_leveling_commit(), WEAR_LEVELING_FAILED) << "Unbalanced commit should fail";
+
+    uint8_t readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    wear_leveling_read(0x03, &readback, sizeof(readback));
+    EXPECT_EQ(readback, a) << "Invalid readback after playback";
+    wear_leveling_read(0x83, &readback, sizeof(readback));
+    EXPECT_EQ(readback, b) << "Invalid readback after playback";
+}
+
+/**
+ * This test verifies that an extent cut short during commit is discarded during playback, leaving the previous values in place.
+ */
+TEST_F(WearLevelingBatch, TornExtentDiscarded) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t before = 0x5A;
+    EXPECT_EQ(wear_leveling_write(0x10, &before, sizeof(before)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    std::uint64_t writes_before = inst.write_invoke_count();
+
+    // Fail every backing store write after the extent header
+    inst.set_write_callback([writes_before](std::uint64_t count, std::uint32_t) { return count <= writes_before + sizeof(write_log_entry_t) / BACKING_STORE_WRITE_SIZE; });
+
+    std::array<std::uint8_t, 32> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x80);
+    wear_leveling_begin();
+    wear_leveling_write(0x10, testvalue.data(), testvalue.size());
+    EXPECT_EQ(wear_leveling_commit(), WEAR_LEVELING_FAILED) << "Commit should have failed";
+
+    // Simulate a reboot, with the header of the extent present but its data missing
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Torn extent should have forced a consolidation";
+
+    uint8_t readback;
+    wear_leveling_read(0x10, &readback, sizeof(readback));
+    EXPECT_EQ(readback, before) << "Torn extent should not have been applied";
+    wear_leveling_read(0x11, &readback, sizeof(readback));
+    EXPECT_EQ(readback, 0) << "Torn extent should not have been applied";
+}
+
+/**
+ * This test verifies that committing an extent which does not fit in the write log consolidates instead.
+ */
+TEST_F(WearLevelingBatch, OversizedExtentConsolidates) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x01);
+
+    // Fill most of the write log with single-byte writes
+    uint8_t filler = 0;
+    while (inst.erasure_count() == 0 && wear_leveling_write(0x02, &(++filler), sizeof(filler)) == WEAR_LEVELING_SUCCESS) {
+        std::uint64_t used = inst.write_invoke_count() * BACKING_STORE_WRITE_SIZE;
+        if (used + extent_backing_writes(testvalue.size()) * BACKING_STORE_WRITE_SIZE > WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) {
+            break;
+        }
+    }
+    EXPECT_EQ(inst.erasure_count(), 0) << "Write log should not have been consolidated yet";
+
+    wear_leveling_begin();
+    wear_leveling_write(0, testvalue.data(), testvalue.size());
+    EXPECT_EQ(wear_leveling_commit(), WEAR_LEVELING_CONSOLIDATED) << "Commit should have consolidated";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    wear_leveling_read(0, readback.data(), readback.size());
+    EXPECT_EQ(readback, testvalue) << "Invalid readback after consolidation";
+}
+
+/**
+ * This test verifies that batching a keymap-style upload results in fewer consolidations than writing it piecewise.
+ */
+TEST_F(WearLevelingBatch, FewerConsolidationsThanUnbatched) {
+    auto& inst = MockBackingStore::Instance();
+
+    auto upload = [](bool batched, int round) {
+        for (std::size_t chunk = 0; chunk < WEAR_LEVELING_LOGICAL_SIZE; chunk += 28) {
+            if (batched) wear_leveling_begin();
+            for (std::size_t i = chunk; i < chunk + 28 && i + 2 <= WEAR_LEVELING_LOGICAL_SIZE; i += 2) {
+                uint16_t keycode = 0x1000 + i + round;
+                wear_leveling_write(i, &keycode, sizeof(keycode));
+            }
+            if (batched) wear_leveling_commit();
+        }
+    };
+
+    for (int round = 0; round < 8; ++round) {
+        upload(false, round);
+    }
+    std::uint64_t unbatched_erases = inst.erasure_count();
+
+    inst.reset_instance();
+    wear_leveling_init();
+    for (int round = 0; round < 8; ++round) {
+        upload(true, round);
+    }
+    std::uint64_t batched_erases = inst.erasure_count();
+
+    EXPECT_LT(batched_erases, unbatched_erases) << "Batched uploads should consolidate less often";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    for (std::size_t i = 0; i + 2 <= WEAR_LEVELING_LOGICAL_SIZE; i += 2) {
+        uint16_t keycode;
+        wear_leveling_read(i, &keycode, sizeof(keycode));
+        EXPECT_EQ(keycode, 0x1000 + i + 7) << "Invalid readback after playback";
+    }
+}
@@ -0,0 +1,197 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <cmath>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingCheckpoint : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+        rng_state = 1;
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+    std::uint32_t                                        rng_state;
+
+    // Performs a keymap-style 2-byte write at a pseudo-random location, returns false if the log was consolidated
+    bool random_write() {
+        rng_state         = rng_state * 1103515245 + 12345;
+        uint32_t address  = ((rng_state >> 8) % (WEAR_LEVELING_LOGICAL_SIZE / 2)) * 2;
+        uint16_t keycode  = 0x0100 + ((rng_state >> 20) & 0xFF);
+        memcpy(&verify_data[address], &keycode, sizeof(keycode));
+        return wear_leveling_write(address, &keycode, sizeof(keycode)) == WEAR_LEVELING_SUCCESS;
+    }
+
+    // Number of bytes of write log used so far, including the checkpoint index
+    std::uint64_t log_bytes() const {
+        return MockBackingStore::Instance().total_write_count() * BACKING_STORE_WRITE_SIZE;
+    }
+
+    void verify_readback() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, verify_data) << "Invalid readback";
+    }
+
+    // Writes the first `length` bytes of a log entry, a backing store word at a time
+    template <typename Iterator>
+    void set_entry(Iterator element, const write_log_entry_t& entry, std::size_t length) {
+        for (std::size_t i = 0; i * BACKING_STORE_WRITE_SIZE < length; ++i) {
+            backing_store_int_t value;
+            memcpy(&value, &entry.raw8[i * BACKING_STORE_WRITE_SIZE], sizeof(value));
+            (element + i)->set(~value);
+        }
+    }
+
+    backing_store_int_t index_entry(std::size_t slot) {
+        return ~(MockBackingStore::Instance().storage_begin() + (WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS / BACKING_STORE_WRITE_SIZE) + slot)->get();
+    }
+};
+
+/**
+ * This test verifies that a checkpoint is indexed once enough of the write log has been used, and that playback from it is correct.
+ */
+TEST_F(WearLevelingCheckpoint, CheckpointIndexedAfterInterval) {
+    while (log_bytes() < WEAR_LEVELING_CHECKPOINT_INTERVAL) {
+        EXPECT_EQ(index_entry(0), 0) << "Checkpoint written too early";
+        ASSERT_TRUE(random_write()) << "Unexpected consolidation";
+    }
+    ASSERT_TRUE(random_write()) << "Unexpected consolidation";
+    EXPECT_NE(index_entry(0), 0) << "Checkpoint should have been indexed";
+    EXPECT_EQ(index_entry(1), 0) << "Only one checkpoint should have been indexed";
+
+    // A few more writes after the checkpoint, then play back from scratch
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_TRUE(random_write()) << "Unexpected consolidation";
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+
+    // Writes continue to be logged and checkpointed correctly after playback from a checkpoint
+    while (index_entry(1) == 0) {
+        ASSERT_TRUE(random_write()) << "Unexpected consolidation";
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that a corrupted checkpoint is not used, and that the data logged before it survives.
+ */
+TEST_F(WearLevelingCheckpoint, CorruptCheckpointIgnored) {
+    auto& inst = MockBackingStore::Instance();
+
+    while (index_entry(0) == 0) {
+        ASSERT_TRUE(random_write()) << "Unexpected consolidation";
+    }
+    auto before_checkpoint = verify_data;
+
+    // Corrupt the data of the checkpoint
+    uint32_t checkpoint = index_entry(0) * BACKING_STORE_WRITE_SIZE;
+    auto     element    = inst.storage_begin() + (checkpoint + sizeof(write_log_entry_t) + 16) / BACKING_STORE_WRITE_SIZE;
+    element->erase();
+    element->set(~(backing_store_int_t)0x5A5A);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Corrupt checkpoint should have forced a consolidation";
+    verify_data = before_checkpoint;
+    verify_readback();
+}
+
+/**
+ * This test verifies that consolidation clears the checkpoint index.
+ */
+TEST_F(WearLevelingCheckpoint, ConsolidationClearsIndex) {
+    while (random_write()) {
+    }
+    EXPECT_EQ(MockBackingStore::Instance().erasure_count(), 1) << "Write log should have been consolidated";
+    EXPECT_EQ(index_entry(0), 0) << "Checkpoint index should have been cleared";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that a write log written without checkpoints, which starts where the layout marker now lives, is
+ * played back from there and consolidated into the checkpoint layout.
+ */
+TEST_F(WearLevelingCheckpoint, LogWithoutCheckpointsMigrated) {
+    auto& inst     = MockBackingStore::Instance();
+    auto  logstart = inst.storage_begin() + (WEAR_LEVELING_LAYOUT_ADDRESS / BACKING_STORE_WRITE_SIZE);
+    inst.reset_instance();
+
+    // Set up a 2-byte logical write of [0x11,0x12] at logical offset 0x01, starting at what is now the layout marker
+    auto entry0    = LOG_ENTRY_MAKE_MULTIBYTE(0x01, 2);
+    entry0.raw8[3] = 0x11;
+    entry0.raw8[4] = 0x12;
+    set_entry(logstart, entry0, 3 + 2); // 3 bytes of header, then the data
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Foreign layout should have forced a consolidation";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Invalid final erase count";
+    verify_data[1] = 0x11;
+    verify_data[2] = 0x12;
+    verify_readback();
+
+    // The layout is now recognised, and the data survives another playback
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Layout should not have been migrated twice";
+    verify_readback();
+}
+
+/**
+ * This test verifies that a write log written with a different number of checkpoint slots is played back from where
+ * it starts and consolidated into this layout.
+ */
+TEST_F(WearLevelingCheckpoint, DifferentSlotCountMigrated) {
+    auto& inst = MockBackingStore::Instance();
+    inst.reset_instance();
+
+    write_log_entry_t marker                  = {.raw64 = 0};
+    marker.raw8[0]                            = (LOG_ENTRY_TYPE_EXTENDED << 6) | (LOG_ENTRY_EXTENDED_LAYOUT << 3);
+    marker.raw8[BACKING_STORE_WRITE_SIZE - 1] = 3;
+    set_entry(inst.storage_begin() + (WEAR_LEVELING_LAYOUT_ADDRESS / BACKING_STORE_WRITE_SIZE), marker, BACKING_STORE_WRITE_SIZE);
+
+    auto logstart  = inst.storage_begin() + (WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS / BACKING_STORE_WRITE_SIZE) + 3;
+    auto entry0    = LOG_ENTRY_MAKE_MULTIBYTE(0x20, 2);
+    entry0.raw8[3] = 0x21;
+    entry0.raw8[4] = 0x22;
+    set_entry(logstart, entry0, 3 + 2); // 3 bytes of header, then the data
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Foreign layout should have forced a consolidation";
+    verify_data[0x20] = 0x21;
+    verify_data[0x21] = 0x22;
+    verify_readback();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This benchmark measures the number of backing store reads made during initialisation as the write log fills up.
+ * Without checkpoints, playback reads every word of the write log.
+ */
+TEST_F(WearLevelingCheckpoint, ReplayCostAgainstLogFill) {
+    auto& inst = MockBackingStore::Instance();
+
+    constexpr std::size_t log_size   = WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOG_START;
+    const std::size_t     index_cost = (std::size_t)std::ceil(std::log2(WEAR_LEVELING_CHECKPOINT_SLOTS + 1)) + 1;
+    // Index search, checkpoint, and at most an interval plus a skipped checkpoint's worth of log after it
+    const std::size_t bound = index_cost + (sizeof(write_log_entry_t) + WEAR_LEVELING_LOGICAL_SIZE + WEAR_LEVELING_CHECKPOINT_INTERVAL + sizeof(write_log_entry_t) + WEAR_LEVELING_LOGICAL_SIZE + 16) / BACKING_STORE_WRITE_SIZE;
+
+    for (int percent = 10; percent <= 90; percent += 10) {
+        inst.reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+        while (log_bytes() < log_size * percent / 100) {
+            ASSERT_TRUE(random_write()) << "Unexpected consolidation";
+        }
+
+        std::uint64_t reads_before = inst.read_invoke_count();
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        std::uint64_t reads = inst.read_invoke_count() - reads_before;
+        verify_readback();
+
+        EXPECT_LE(reads, bound) << "Playback should be bounded by the checkpoint interval, not the log fill";
+    }
+}
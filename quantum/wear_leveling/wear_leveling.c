@@ -153,7 +153,50 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Extent log entries:
+
+        Writes made between wear_leveling_begin() and wear_leveling_commit()
+        only update the cache. On commit, each run of changed data is appended
+        as a single extent -- an 8-byte header followed by the raw data, padded
+        to the backing store write size -- rather than as many multi-byte
+        entries of up to 5 bytes each.
+
+        ╔ Extent Header ════════════════════════════════════════════════════════╗
+        ║11000YYY║YYYYYYYY║YYYYYYYY║LLLLLLLL║LLLLLLLL║CCCCCCCC║CCCCCCCC║CCCCCCCC║
+        ║  └┬┘└┬┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║
+        ║  SubAdd║ Address║ Address║ Length ║ Length ║Checksum║Checksum║Checksum║
+        ╚════════╩════════╩════════╩════════╩════════╩════════╩════════╩════════╝
+
+        The checksum is a 24-bit fold of the FNV1a_32 of the first five header
+        bytes and the data. As the data may contain zeros, an extent cut short
+        by a power loss cannot be told apart from the end of the log by its
+        contents alone -- the checksum fails instead, and the extent is
+        discarded during playback.
+
+    Checkpoints:
+
+        With WEAR_LEVELING_CHECKPOINT_INTERVAL defined, an index of
+        WEAR_LEVELING_CHECKPOINT_SLOTS backing store writes sits between the
+        FNV1a_64 hash and the write log. Whenever at least the interval's worth
+        of log has been written since the previous checkpoint, the whole cache
+        is appended to the log as a checkpoint -- an extent with its own
+        subtype -- and the next index entry is set to its address divided by
+        the backing store write size.
+
+        Index entries are only ever filled in order, so at startup a binary
+        search finds the latest one. The checkpoint it points at replaces the
+        consolidated data, and playback continues from just after it. If the
+        checkpoint fails validation, the consolidated data and the entire write
+        log are played back instead, as without checkpoints.
+
+        The index is preceded by a single layout marker -- an extended entry
+        with its own subtype, holding the number of index slots -- written
+        whenever the backing store is erased. If a different marker, or a
+        regular log entry, is found there at startup, the backing store was
+        written by a build whose write log starts elsewhere. That log is played
+        back from where it starts, and then consolidated into this layout. */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,6 +205,12 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+    uint8_t                                                        batch_depth;
+    uint8_t                                                        batch_dirty[(WEAR_LEVELING_BATCH_GRANULES + 7) / 8];
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    uint32_t checkpoint_address;
+    uint32_t checkpoint_count;
+#endif
 } wear_leveling;
 
 /**
@@ -202,9 +251,83 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+}
+
+/**
+ * Forgets all checkpoints, for when the write log is emptied.
+ */
+static void wear_leveling_clear_checkpoints(void) {
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.checkpoint_address = WEAR_LEVELING_LOG_START;
+    wear_leveling.checkpoint_count   = 0;
+#endif
+}
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+/**
+ * Builds the layout marker for this build's checkpoint index size.
+ */
+static backing_store_int_t wear_leveling_layout_marker(void) {
+    write_log_entry_t log = {.raw64 = 0};
+    log.raw8[0]           = (((uint8_t)LOG_ENTRY_TYPE_EXTENDED) << 6) | (((uint8_t)LOG_ENTRY_EXTENDED_LAYOUT) << 3) | (((uint64_t)(WEAR_LEVELING_CHECKPOINT_SLOTS) >> (8 * ((BACKING_STORE_WRITE_SIZE)-1))) & BITMASK_FOR_BITCOUNT(3));
+    for (size_t i = 1; i < (BACKING_STORE_WRITE_SIZE); ++i) {
+        log.raw8[i] = (uint8_t)((uint64_t)(WEAR_LEVELING_CHECKPOINT_SLOTS) >> (8 * ((BACKING_STORE_WRITE_SIZE)-1 - i)));
+    }
+    backing_store_int_t value;
+    memcpy(&value, log.raw8, (BACKING_STORE_WRITE_SIZE));
+    return value;
 }
 
+/**
+ * Records the layout of the backing store, so that a build with a different checkpoint configuration can tell where
+ * the write log starts.
+ * Pre-condition: this is just after an erase, so we can write directly without reading.
+ */
+static bool wear_leveling_write_layout(void) {
+    return backing_store_write(WEAR_LEVELING_LAYOUT_ADDRESS, wear_leveling_layout_marker());
+}
+
+/**
+ * Checks the layout marker against this build's.
+ *
+ * A blank marker is either a freshly erased backing store or one written without checkpoints whose write log is
+ * empty, both of which can be used as-is. Anything else that is not a layout marker is the first entry of a write log
+ * written without checkpoints, as no regular log entry can look like one.
+ *
+ * @return zero if the write log is where this build expects it, otherwise the address the write log actually starts at
+ */
+static uint32_t wear_leveling_read_layout(void) {
+    backing_store_int_t value;
+    if (!backing_store_read(WEAR_LEVELING_LAYOUT_ADDRESS, &value) || value == 0 || value == wear_leveling_layout_marker()) {
+        return 0;
+    }
+
+    write_log_entry_t log = {.raw64 = 0};
+    memcpy(log.raw8, &value, (BACKING_STORE_WRITE_SIZE));
+    if (LOG_ENTRY_GET_TYPE(log) != LOG_ENTRY_TYPE_EXTENDED || LOG_ENTRY_EXTENDED_GET_SUBTYPE(log) != LOG_ENTRY_EXTENDED_LAYOUT) {
+        wl_dprintf("Write log was written without checkpoints\n");
+        return WEAR_LEVELING_LAYOUT_ADDRESS;
+    }
+
+    uint64_t slots = log.raw8[0] & BITMASK_FOR_BITCOUNT(3);
+    for (size_t i = 1; i < (BACKING_STORE_WRITE_SIZE); ++i) {
+        slots = (slots << 8) | log.raw8[i];
+    }
+    wl_dprintf("Write log was written with %d checkpoint slots\n", (int)slots);
+    const uint64_t start = (WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS) + slots * (BACKING_STORE_WRITE_SIZE);
+    return start < (WEAR_LEVELING_BACKING_SIZE) ? (uint32_t)start : (WEAR_LEVELING_BACKING_SIZE);
+}
+#else
+static inline bool wear_leveling_write_layout(void) {
+    return true;
+}
+
+static inline uint32_t wear_leveling_read_layout(void) {
+    return 0;
+}
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -285,6 +408,10 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
                 break;
             }
 #endif
+            if (!wear_leveling_write_layout()) {
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
         } while (0);
     }
 
@@ -316,7 +443,8 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+    wear_leveling_clear_checkpoints();
 
     return status;
 }
@@ -470,14 +598,219 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
 }
 
 /**
- * "Replays" the write log from the backing store, updating the local cache with updated values.
+ * Calculates the checksum stored in an extent header.
+ */
+static uint32_t wear_leveling_extent_checksum(const write_log_entry_t *header, const uint8_t *data, size_t length) {
+    Fnv32_t hash = fnv_32a_buf((void *)header->raw8, LOG_ENTRY_EXTENT_CHECKSUM_BYTES, FNV1_32A_INIT);
+    hash         = fnv_32a_buf((void *)data, length, hash);
+    return ((hash >> 24) ^ hash) & BITMASK_FOR_BITCOUNT(24);
+}
+
+/**
+ * Appends the cached logical data at the given range to the write log as a single extent.
+ * If the extent would not fit in the rest of the write log, the cache is consolidated instead.
+ *
+ * @return WEAR_LEVELING_SUCCESS if the extent was appended, WEAR_LEVELING_CONSOLIDATED if the cache was consolidated
+ * instead of (or part way through) appending it, which also persists the range, or WEAR_LEVELING_FAILED if the
+ * backing store could not be written
+ */
+static wear_leveling_status_t wear_leveling_write_raw_extent(uint8_t subtype, uint32_t address, size_t length) {
+    const size_t data_size = (length + (BACKING_STORE_WRITE_SIZE)-1) / (BACKING_STORE_WRITE_SIZE) * (BACKING_STORE_WRITE_SIZE);
+    if (wear_leveling.write_address + sizeof(write_log_entry_t) + data_size > (WEAR_LEVELING_BACKING_SIZE)) {
+        return wear_leveling_consolidate_force();
+    }
+
+    const uint8_t *   p        = &wear_leveling.cache[address];
+    write_log_entry_t log      = LOG_ENTRY_MAKE_EXTENT(subtype, address, length, 0);
+    uint32_t          checksum = wear_leveling_extent_checksum(&log, p, length);
+    log                        = LOG_ENTRY_MAKE_EXTENT(subtype, address, length, checksum);
+
+    // Write the header, then the data. See the extent format in the documentation header at the top of the file.
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (size_t i = 0; i < sizeof(log); i += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        memcpy(&value, &log.raw8[i], (BACKING_STORE_WRITE_SIZE));
+        status = wear_leveling_append_raw(value);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return status;
+        }
+    }
+    for (size_t i = 0; i < length; i += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value = 0;
+        memcpy(&value, &p[i], length - i < (BACKING_STORE_WRITE_SIZE) ? length - i : (BACKING_STORE_WRITE_SIZE));
+        status = wear_leveling_append_raw(value);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return status;
+        }
+    }
+    return status;
+}
+
+/**
+ * Replays an extended write log entry whose first backing store value has already been read into the supplied entry.
+ * The address is advanced past the entry.
+ *
+ * @return false if the entry could not be read, or is invalid
+ */
+static bool wear_leveling_playback_extended(write_log_entry_t *log, uint32_t *address) {
+    // Read the remainder of the 8-byte header
+    for (size_t i = (BACKING_STORE_WRITE_SIZE); i < sizeof(*log); i += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (*address >= (WEAR_LEVELING_BACKING_SIZE) || !backing_store_read(*address, &value)) {
+            return false;
+        }
+        memcpy(&log->raw8[i], &value, (BACKING_STORE_WRITE_SIZE));
+        *address += (BACKING_STORE_WRITE_SIZE);
+    }
+
+    // Checkpoints are applied like any other extent when they are played back as part of the write log
+    if (LOG_ENTRY_EXTENDED_GET_SUBTYPE(*log) != LOG_ENTRY_EXTENDED_EXTENT && LOG_ENTRY_EXTENDED_GET_SUBTYPE(*log) != LOG_ENTRY_EXTENDED_CHECKPOINT) {
+        return false;
+    }
+
+    const uint32_t a         = LOG_ENTRY_EXTENT_GET_ADDRESS(*log);
+    const uint32_t l         = LOG_ENTRY_EXTENT_GET_LENGTH(*log);
+    const uint32_t data_size = (l + (BACKING_STORE_WRITE_SIZE)-1) / (BACKING_STORE_WRITE_SIZE) * (BACKING_STORE_WRITE_SIZE);
+    if (l == 0 || a + l > (WEAR_LEVELING_LOGICAL_SIZE) || *address + data_size > (WEAR_LEVELING_BACKING_SIZE)) {
+        return false;
+    }
+
+    // Verify the data before touching the cache, so that a torn extent leaves the previous values in place
+    Fnv32_t hash = fnv_32a_buf(log->raw8, LOG_ENTRY_EXTENT_CHECKSUM_BYTES, FNV1_32A_INIT);
+    for (uint32_t i = 0; i < l; i += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(*address + i, &value)) {
+            return false;
+        }
+        hash = fnv_32a_buf(&value, l - i < (BACKING_STORE_WRITE_SIZE) ? l - i : (BACKING_STORE_WRITE_SIZE), hash);
+    }
+    if ((((hash >> 24) ^ hash) & BITMASK_FOR_BITCOUNT(24)) != LOG_ENTRY_EXTENT_GET_CHECKSUM(*log)) {
+        wl_dprintf("Extent checksum mismatch\n");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < l; i += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(*address + i, &value)) {
+            return false;
+        }
+        memcpy(&wear_leveling.cache[a + i], &value, l - i < (BACKING_STORE_WRITE_SIZE) ? l - i : (BACKING_STORE_WRITE_SIZE));
+    }
+    *address += data_size;
+    return true;
+}
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+/**
+ * Appends a snapshot of the cache to the write log once enough has been logged since the previous one, and records
+ * its location in the checkpoint index so that playback can start from there.
+ */
+static wear_leveling_status_t wear_leveling_checkpoint_if_needed(void) {
+    if (wear_leveling.checkpoint_count >= WEAR_LEVELING_CHECKPOINT_SLOTS || wear_leveling.write_address - wear_leveling.checkpoint_address < (WEAR_LEVELING_CHECKPOINT_INTERVAL)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Not worth it if the log would be full straight afterwards, as it'll be consolidated on the next write
+    if (wear_leveling.write_address + sizeof(write_log_entry_t) + (WEAR_LEVELING_LOGICAL_SIZE) >= (WEAR_LEVELING_BACKING_SIZE)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Writing checkpoint %d\n", (int)wear_leveling.checkpoint_count);
+    const uint32_t         address = wear_leveling.write_address;
+    wear_leveling_status_t status  = wear_leveling_write_raw_extent(LOG_ENTRY_EXTENDED_CHECKPOINT, 0, (WEAR_LEVELING_LOGICAL_SIZE));
+    if (status != WEAR_LEVELING_SUCCESS) {
+        return status;
+    }
+
+    // The index entry is only written once the checkpoint is complete, so an interrupted checkpoint is never used
+    if (!backing_store_write(WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS + wear_leveling.checkpoint_count * (BACKING_STORE_WRITE_SIZE), address / (BACKING_STORE_WRITE_SIZE))) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+    wear_leveling.checkpoint_address = address;
+    ++wear_leveling.checkpoint_count;
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Loads the cache from the latest checkpoint, if there is a valid one.
+ *
+ * @return the address in the write log to continue playback from, or zero if the consolidated data and the whole
+ * write log need to be played back instead
  */
-static wear_leveling_status_t wear_leveling_playback_log(void) {
+static uint32_t wear_leveling_read_checkpoint(void) {
+    // Index entries are written in order, so binary search for the first empty one
+    uint32_t lo = 0;
+    uint32_t hi = WEAR_LEVELING_CHECKPOINT_SLOTS;
+    while (lo < hi) {
+        const uint32_t      mid = lo + (hi - lo) / 2;
+        backing_store_int_t value;
+        if (!backing_store_read(WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS + mid * (BACKING_STORE_WRITE_SIZE), &value)) {
+            return 0;
+        }
+        if (value != 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    wear_leveling.checkpoint_count = lo;
+    if (lo == 0) {
+        return 0;
+    }
+
+    backing_store_int_t value;
+    if (!backing_store_read(WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS + (lo - 1) * (BACKING_STORE_WRITE_SIZE), &value)) {
+        return 0;
+    }
+    const uint32_t address = (uint32_t)value * (BACKING_STORE_WRITE_SIZE);
+    if (address < WEAR_LEVELING_LOG_START || address + sizeof(write_log_entry_t) + (WEAR_LEVELING_LOGICAL_SIZE) > (WEAR_LEVELING_BACKING_SIZE)) {
+        return 0;
+    }
+
+    write_log_entry_t log;
+    for (size_t i = 0; i < sizeof(log); i += (BACKING_STORE_WRITE_SIZE)) {
+        if (!backing_store_read(address + i, &value)) {
+            return 0;
+        }
+        memcpy(&log.raw8[i], &value, (BACKING_STORE_WRITE_SIZE));
+    }
+    if (LOG_ENTRY_GET_TYPE(log) != LOG_ENTRY_TYPE_EXTENDED || LOG_ENTRY_EXTENDED_GET_SUBTYPE(log) != LOG_ENTRY_EXTENDED_CHECKPOINT || LOG_ENTRY_EXTENT_GET_ADDRESS(log) != 0 || LOG_ENTRY_EXTENT_GET_LENGTH(log) != (WEAR_LEVELING_LOGICAL_SIZE)) {
+        return 0;
+    }
+
+    // Any failure from here on leaves the cache to be overwritten by the consolidated data
+    wl_dprintf("Reading checkpoint %d\n", (int)(lo - 1));
+    if (!backing_store_read_bulk(address + sizeof(log), (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+        return 0;
+    }
+    if (wear_leveling_extent_checksum(&log, wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE)) != LOG_ENTRY_EXTENT_GET_CHECKSUM(log)) {
+        wl_dprintf("Checkpoint checksum mismatch\n");
+        return 0;
+    }
+
+    wear_leveling.checkpoint_address = address;
+    return address + sizeof(log) + (WEAR_LEVELING_LOGICAL_SIZE);
+}
+#else
+static inline wear_leveling_status_t wear_leveling_checkpoint_if_needed(void) {
+    return WEAR_LEVELING_SUCCESS;
+}
+
+static inline uint32_t wear_leveling_read_checkpoint(void) {
+    return 0;
+}
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+/**
+ * "Replays" the write log from the backing store, starting at the given address, updating the local cache with updated values.
+ */
+static wear_leveling_status_t wear_leveling_playback_log(uint32_t address) {
     wl_dprintf("Playback write log\n");
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
     while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
@@ -590,6 +923,12 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 wear_leveling.cache[a + 1] = 0;
             } break;
 #endif // BACKING_STORE_WRITE_SIZE == 2
+            case LOG_ENTRY_TYPE_EXTENDED: {
+                if (!wear_leveling_playback_extended(&log, &address)) {
+                    cancel_playback = true;
+                    status          = WEAR_LEVELING_FAILED;
+                }
+            } break;
             default: {
                 cancel_playback = true;
                 status          = WEAR_LEVELING_FAILED;
@@ -617,8 +956,11 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
-    // Reset the cache
+    // Reset the cache, dropping any open write batch
     wear_leveling_clear_cache();
+    wear_leveling_clear_checkpoints();
+    wear_leveling.batch_depth = 0;
+    memset(wear_leveling.batch_dirty, 0, sizeof(wear_leveling.batch_dirty));
 
     // Initialise the backing store
     if (!backing_store_init()) {
@@ -627,15 +969,38 @@ wear_leveling_status_t wear_leveling_init(void) {
         return WEAR_LEVELING_FAILED;
     }
 
-    // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
-    wear_leveling_status_t status = wear_leveling_read_consolidated();
+    // A write log left behind by a build with a different checkpoint configuration starts somewhere else -- play it back
+    // from there on top of the consolidated values, then consolidate once so that the layout matches this build
+    wear_leveling_status_t status        = WEAR_LEVELING_SUCCESS;
+    uint32_t               foreign_start = wear_leveling_read_layout();
+    if (foreign_start != 0) {
+        status = wear_leveling_read_consolidated();
+        if (status != WEAR_LEVELING_FAILED) {
+            status = wear_leveling_playback_log(foreign_start);
+        }
+        if (status == WEAR_LEVELING_SUCCESS) {
+            status = wear_leveling_consolidate_force();
+        }
+        if (status == WEAR_LEVELING_FAILED) {
+            // If it failed, clear the cache and return with failure
+            wear_leveling_clear_cache();
+        }
+        return status;
+    }
+
+    // Read the latest checkpoint, or otherwise the previous consolidated values, then replay the rest of the write log so that the cache has the "live" values
+    uint32_t playback_address = wear_leveling_read_checkpoint();
+    if (playback_address == 0) {
+        playback_address = WEAR_LEVELING_LOG_START;
+        status           = wear_leveling_read_consolidated();
+    }
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
         return status;
     }
 
-    status = wear_leveling_playback_log();
+    status = wear_leveling_playback_log(playback_address);
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -661,7 +1026,12 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+    if (ret) {
+        ret = wear_leveling_write_layout();
+    }
     wear_leveling_clear_cache();
+    wear_leveling_clear_checkpoints();
+    memset(wear_leveling.batch_dirty, 0, sizeof(wear_leveling.batch_dirty));
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -691,6 +1061,14 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+    // Inside a batch, only keep track of what needs to be written on commit
+    if (wear_leveling.batch_depth > 0) {
+        for (uint32_t granule = address / (WEAR_LEVELING_BATCH_GRANULARITY); granule <= (address + length - 1) / (WEAR_LEVELING_BATCH_GRANULARITY); ++granule) {
+            wear_leveling.batch_dirty[granule / 8] |= (1 << (granule % 8));
+        }
+        return WEAR_LEVELING_SUCCESS;
+    }
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -707,8 +1085,11 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
             break;
 
         case WEAR_LEVELING_SUCCESS:
-            // Consolidate the cache + write log if required
+            // Consolidate the cache + write log if required, otherwise checkpoint if it's due
             status = wear_leveling_consolidate_if_needed();
+            if (status == WEAR_LEVELING_SUCCESS) {
+                status = wear_leveling_checkpoint_if_needed();
+            }
             break;
 
         default:
@@ -726,6 +1107,73 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Starts a write batch.
+ */
+wear_leveling_status_t wear_leveling_begin(void) {
+    if (wear_leveling.batch_depth == UINT8_MAX) {
+        return WEAR_LEVELING_FAILED;
+    }
+    ++wear_leveling.batch_depth;
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Ends a write batch, appending everything written during it to the write log as extents.
+ */
+wear_leveling_status_t wear_leveling_commit(void) {
+    wl_assert(wear_leveling.batch_depth > 0);
+    if (wear_leveling.batch_depth == 0) {
+        return WEAR_LEVELING_FAILED;
+    }
+    if (--wear_leveling.batch_depth > 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status  = WEAR_LEVELING_SUCCESS;
+    uint32_t               granule = 0;
+    while (status == WEAR_LEVELING_SUCCESS && granule < WEAR_LEVELING_BATCH_GRANULES) {
+        if (!(wear_leveling.batch_dirty[granule / 8] & (1 << (granule % 8)))) {
+            ++granule;
+            continue;
+        }
+
+        // Gather the run of dirty granules into a single extent
+        uint32_t start = granule;
+        while (granule < WEAR_LEVELING_BATCH_GRANULES && (wear_leveling.batch_dirty[granule / 8] & (1 << (granule % 8))) && (granule - start + 1) * (WEAR_LEVELING_BATCH_GRANULARITY) <= LOG_ENTRY_EXTENT_MAX_BYTES) {
+            wear_leveling.batch_dirty[granule / 8] &= ~(1 << (granule % 8));
+            ++granule;
+        }
+
+        const uint32_t address = start * (WEAR_LEVELING_BATCH_GRANULARITY);
+        const uint32_t end     = granule * (WEAR_LEVELING_BATCH_GRANULARITY) < (WEAR_LEVELING_LOGICAL_SIZE) ? granule * (WEAR_LEVELING_BATCH_GRANULARITY) : (WEAR_LEVELING_LOGICAL_SIZE);
+        wl_dprintf("Commit ");
+        wl_dump(address, &wear_leveling.cache[address], end - address);
+        status = wear_leveling_write_raw_extent(LOG_ENTRY_EXTENDED_EXTENT, address, end - address);
+    }
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_checkpoint_if_needed();
+    }
+
+    // Consolidation persists the entire cache, and a failure leaves nothing sensible to retry, so the batch is done either way
+    memset(wear_leveling.batch_dirty, 0, sizeof(wear_leveling.batch_dirty));
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
 /**
  * Reads logical data from the cache.
  */
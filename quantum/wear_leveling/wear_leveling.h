@@ -43,6 +43,27 @@ wear_leveling_status_t wear_leveling_erase(void);
  */
 wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value, size_t length);
 
+/**
+ * Starts a write batch.
+ *
+ * Until the matching wear_leveling_commit(), writes only update the cache and are not persisted. Batches may be nested,
+ * in which case only the outermost commit writes to the backing store.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_begin(void);
+
+/**
+ * Ends a write batch.
+ *
+ * Everything written since the outermost wear_leveling_begin() is appended to the write log, with each contiguous run of
+ * changes stored as a single extent instead of many small log entries. Each extent is applied as a whole during
+ * playback, or not at all if it was cut short by a power loss.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_commit(void);
+
 /**
  * Reads logical data from the cache.
  *
@@ -27,6 +27,29 @@ typedef uint64_t backing_store_int_t;
 #    error WEAR_LEVELING_LOGICAL_SIZE was not set.
 #endif
 
+// Granularity of the dirty tracking used while a write batch is open
+#ifndef WEAR_LEVELING_BATCH_GRANULARITY
+#    define WEAR_LEVELING_BATCH_GRANULARITY 8
+#endif
+
+#define WEAR_LEVELING_BATCH_GRANULES (((WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BATCH_GRANULARITY)-1) / (WEAR_LEVELING_BATCH_GRANULARITY))
+
+// With WEAR_LEVELING_CHECKPOINT_INTERVAL set, a snapshot of the logical data is appended to the write log whenever at
+// least that many bytes of log have been written since the previous one, and an index of the snapshots is kept
+// between the consolidated data and the write log. The index is preceded by a layout marker recording its size, as
+// the write log starts further into the backing store than it would otherwise.
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+#    define WEAR_LEVELING_LAYOUT_WORDS 1
+#    define WEAR_LEVELING_CHECKPOINT_SLOTS (((WEAR_LEVELING_BACKING_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE)-8 - (BACKING_STORE_WRITE_SIZE)) / (WEAR_LEVELING_CHECKPOINT_INTERVAL))
+#else
+#    define WEAR_LEVELING_LAYOUT_WORDS 0
+#    define WEAR_LEVELING_CHECKPOINT_SLOTS 0
+#endif
+
+#define WEAR_LEVELING_LAYOUT_ADDRESS ((WEAR_LEVELING_LOGICAL_SIZE) + 8) // +8 due to the FNV1a_64 of the consolidated area
+#define WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS (WEAR_LEVELING_LAYOUT_ADDRESS + (WEAR_LEVELING_LAYOUT_WORDS) * (BACKING_STORE_WRITE_SIZE))
+#define WEAR_LEVELING_LOG_START (WEAR_LEVELING_CHECKPOINT_INDEX_ADDRESS + (WEAR_LEVELING_CHECKPOINT_SLOTS) * (BACKING_STORE_WRITE_SIZE))
+
 #ifdef WEAR_LEVELING_DEBUG_OUTPUT
 #    include <debug.h>
 #    define bs_dprintf(...) dprintf("Backing store: " __VA_ARGS__)
@@ -65,6 +88,12 @@ typedef uint64_t backing_store_int_t;
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+_Static_assert(WEAR_LEVELING_CHECKPOINT_SLOTS > 0, "Checkpoint interval must be smaller than the write log");
+_Static_assert(WEAR_LEVELING_LOGICAL_SIZE <= 0xFFFF, "Checkpoints require a logical size that fits in a single extent");
+_Static_assert((WEAR_LEVELING_BACKING_SIZE) / (BACKING_STORE_WRITE_SIZE) <= (((uint64_t)-1) >> (64 - 8 * (BACKING_STORE_WRITE_SIZE))), "Checkpoint index entries cannot address the entire backing store");
+_Static_assert(WEAR_LEVELING_CHECKPOINT_SLOTS < (((uint64_t)1) << (8 * (BACKING_STORE_WRITE_SIZE)-5)), "Too many checkpoint slots to fit into the layout marker");
+#endif
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -101,6 +130,9 @@ enum {
     // 0x02 -- 2-byte backing store write optimization: word-encoded 0/1 values
     LOG_ENTRY_TYPE_WORD_01,
 
+    // 0x03 -- Extended entry, 8-byte header with a subtype discriminator
+    LOG_ENTRY_TYPE_EXTENDED,
+
     LOG_ENTRY_TYPES
 };
 
@@ -149,3 +181,45 @@ _Static_assert(LOG_ENTRY_TYPES <= (1 << 2), "Too many log entry types to fit int
             [1] = (uint8_t)((address) >> 1), /* address */                                            \
         }                                                                                             \
     }
+
+/**
+ * Extended log entry subtype discriminator.
+ */
+enum {
+    // 0x00 -- Extent: address, length and checksum, followed by the raw data
+    LOG_ENTRY_EXTENDED_EXTENT,
+
+    // 0x01 -- Checkpoint: an extent covering all of the logical data
+    LOG_ENTRY_EXTENDED_CHECKPOINT,
+
+    // 0x02 -- Layout marker: the number of checkpoint index slots, only ever found ahead of the checkpoint index
+    LOG_ENTRY_EXTENDED_LAYOUT,
+
+    LOG_ENTRY_EXTENDED_SUBTYPES
+};
+
+_Static_assert(LOG_ENTRY_EXTENDED_SUBTYPES <= (1 << 3), "Too many extended log entry subtypes to fit into 3 bits of storage");
+
+#define LOG_ENTRY_EXTENDED_GET_SUBTYPE(entry) (((entry).raw8[0] >> 3) & BITMASK_FOR_BITCOUNT(3))
+
+#define LOG_ENTRY_EXTENT_MAX_BYTES 0xFFFF
+#define LOG_ENTRY_EXTENT_CHECKSUM_BYTES 5 // the checksum covers the header bytes before it, then the data
+#define LOG_ENTRY_EXTENT_GET_ADDRESS(entry) LOG_ENTRY_MULTIBYTE_GET_ADDRESS(entry)
+#define LOG_ENTRY_EXTENT_GET_LENGTH(entry) ((((uint32_t)((entry).raw8[3])) << 8) | (entry).raw8[4])
+#define LOG_ENTRY_EXTENT_GET_CHECKSUM(entry) ((((uint32_t)((entry).raw8[5])) << 16) | (((uint32_t)((entry).raw8[6])) << 8) | (entry).raw8[7])
+#define LOG_ENTRY_MAKE_EXTENT(subtype, address, length, checksum)                                   \
+    (write_log_entry_t) {                                                                           \
+        .raw8 = {                                                                                   \
+            [0] = (((((uint8_t)LOG_ENTRY_TYPE_EXTENDED) & BITMASK_FOR_BITCOUNT(2)) << 6) /* type */ \
+                   | ((((uint8_t)(subtype)) & BITMASK_FOR_BITCOUNT(3)) << 3)          /* subtype */ \
+                   | ((((uint8_t)((address) >> 16))) & BITMASK_FOR_BITCOUNT(3))       /* address */ \
+                   ),                                                                               \
+            [1] = (((uint8_t)((address) >> 8)) & BITMASK_FOR_BITCOUNT(8)),   /* address */          \
+            [2] = (((uint8_t)(address)) & BITMASK_FOR_BITCOUNT(8)),          /* address */          \
+            [3] = (((uint8_t)((length) >> 8)) & BITMASK_FOR_BITCOUNT(8)),    /* length */           \
+            [4] = (((uint8_t)(length)) & BITMASK_FOR_BITCOUNT(8)),           /* length */           \
+            [5] = (((uint8_t)((checksum) >> 16)) & BITMASK_FOR_BITCOUNT(8)), /* checksum */         \
+            [6] = (((uint8_t)((checksum) >> 8)) & BITMASK_FOR_BITCOUNT(8)),  /* checksum */         \
+            [7] = (((uint8_t)(checksum)) & BITMASK_FOR_BITCOUNT(8)),         /* checksum */         \
+        }                                                                                           \
+    }
@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CIE1931_CURVE = yes
+
+SRC += $(QUANTUM_DIR)/color.c
+SRC += tests/color/test_hsv_to_rgb_batch.cpp
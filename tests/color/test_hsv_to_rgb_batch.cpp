@@ -0,0 +1,64 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+// hsv_to_rgb_batch() must match hsv_to_rgb() for every input, whatever
+// USE_CIE1931_CURVE and HSV_TO_RGB_LUT are set to for this build.
+class HsvToRgbBatch : public ::testing::Test {
+   protected:
+    void expect_batch_matches(const HSV *hsv, uint8_t count) {
+        RGB rgb[256];
+        hsv_to_rgb_batch(hsv, rgb, count);
+        for (uint8_t i = 0; i < count; i++) {
+            RGB expected = hsv_to_rgb(hsv[i]);
+            ASSERT_EQ(rgb[i].r, expected.r) << "h=" << +hsv[i].h << " s=" << +hsv[i].s << " v=" << +hsv[i].v;
+            ASSERT_EQ(rgb[i].g, expected.g) << "h=" << +hsv[i].h << " s=" << +hsv[i].s << " v=" << +hsv[i].v;
+            ASSERT_EQ(rgb[i].b, expected.b) << "h=" << +hsv[i].h << " s=" << +hsv[i].s << " v=" << +hsv[i].v;
+        }
+    }
+};
+
+TEST_F(HsvToRgbBatch, MatchesSingleConversionAcrossHue) {
+    // Saturation and value stay put along each batch, so the cached terms are reused
+    HSV hsv[256];
+    for (uint16_t s = 0; s < 256; s++) {
+        for (uint16_t v = 0; v < 256; v++) {
+            for (uint16_t h = 0; h < 256; h++) {
+                hsv[h] = (HSV){(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            expect_batch_matches(&hsv[0], 255);
+            expect_batch_matches(&hsv[255], 1);
+            if (HasFatalFailure()) {
+                return;
+            }
+        }
+    }
+}
+
+TEST_F(HsvToRgbBatch, MatchesSingleConversionAcrossValue) {
+    // Value changes on every element, so the cached terms are recomputed each time
+    HSV hsv[256];
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = (HSV){(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            expect_batch_matches(&hsv[0], 255);
+            expect_batch_matches(&hsv[255], 1);
+            if (HasFatalFailure()) {
+                return;
+            }
+        }
+    }
+}
+
+TEST_F(HsvToRgbBatch, FirstElementMatchesInitialCache) {
+    // The cache starts out as s = 0, v = 0, so a leading black pixel must not read stale terms
+    HSV hsv[3] = {{0, 0, 0}, {10, 255, 0}, {0, 0, 0}};
+    expect_batch_matches(hsv, 3);
+}
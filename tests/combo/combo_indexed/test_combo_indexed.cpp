@@ -0,0 +1,82 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ComboIndexed : public TestFixture {};
+
+TEST_F(ComboIndexed, TwoKeyComboFires) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndexed, LongerOverlappingComboWins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndexed, KeyOrderWithinComboDoesNotMatter) {
+    TestDriver driver;
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    KeymapKey  key_d(0, 3, 0, KC_D);
+    set_keymap({key_c, key_d});
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_c, key_d});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndexed, KeySharedBetweenCombos) {
+    TestDriver driver;
+    KeymapKey  key_d(0, 3, 0, KC_D);
+    KeymapKey  key_e(0, 4, 0, KC_E);
+    set_keymap({key_d, key_e});
+
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_d, key_e});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndexed, NonComboKeyPassesThrough) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_f(0, 5, 0, KC_F);
+    set_keymap({key_a, key_f});
+
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_f);
+    VERIFY_AND_CLEAR(driver);
+
+    /* A lone combo key is released after the combo term. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a, COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+}
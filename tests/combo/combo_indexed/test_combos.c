@@ -0,0 +1,20 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { ab_combo, abc_combo, cd_combo, de_combo };
+
+uint16_t const ab_keys[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const abc_keys[] = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const cd_keys[]  = {KC_D, KC_C, COMBO_END};
+uint16_t const de_keys[]  = {KC_D, KC_E, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab_combo]  = COMBO(ab_keys, KC_X),
+    [abc_combo] = COMBO(abc_keys, KC_Y),
+    [cd_combo]  = COMBO(cd_keys, KC_Z),
+    [de_combo]  = COMBO(de_keys, KC_Q),
+};
+// clang-format on
@@ -0,0 +1,127 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+// Vial stores a delay as two bytes, each offset by one so that neither is ever zero
+#define MACRO_DELAY(ms) SS_QMK_PREFIX, SS_DELAY_CODE, (uint8_t)((ms) % 255 + 1), (uint8_t)((ms) / 255 + 1)
+
+class DynamicKeymapMacroAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_macro_reset();
+    }
+
+    void set_macro(const std::vector<uint8_t>& macro) {
+        std::vector<uint8_t> buffer(macro);
+        buffer.push_back(0);
+        dynamic_keymap_macro_set_buffer(0, buffer.size(), buffer.data());
+    }
+};
+
+TEST_F(DynamicKeymapMacroAsync, KeysTypedDuringMacroAreNotDropped) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_x = KeymapKey(0, 0, 0, KC_X);
+
+    set_keymap({key_x});
+    set_macro({'a', MACRO_DELAY(200), 'b'});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(dynamic_keymap_macro_is_playing());
+
+    /* The macro is waiting out its delay, and the keyboard keeps scanning meanwhile. */
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+}
+
+TEST_F(DynamicKeymapMacroAsync, EachKeyEventIsItsOwnStep) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macro({'A'});
+
+    /* The first scan picks the macro up, then a shifted character takes one scan per press or release. */
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    run_one_scan_loop();
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+}
+
+TEST_F(DynamicKeymapMacroAsync, QueuedMacrosPlayInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macro({'a', 0, 'b'});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacroAsync, RewritingTheBufferStopsPlaybackAndReleasesKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macro({SS_QMK_PREFIX, SS_DOWN_CODE, KC_LEFT_SHIFT, MACRO_DELAY(200), 'a', SS_QMK_PREFIX, SS_UP_CODE, KC_LEFT_SHIFT});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    dynamic_keymap_macro_send(0);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Shift must not be left held down by the abandoned macro. */
+    EXPECT_EMPTY_REPORT(driver);
+    set_macro({'c'});
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+}
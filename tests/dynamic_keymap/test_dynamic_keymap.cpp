@@ -0,0 +1,101 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+void set_time(uint32_t t);
+}
+
+#ifndef DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY
+#    define DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY 100
+#endif
+
+#define KEYMAP_BYTES (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+class DynamicKeymapMirror : public TestFixture {
+   public:
+    void SetUp() override {
+        // Every test restarts the clock from zero, but the flush executor expects time to keep moving forwards
+        static uint32_t epoch = 0;
+        epoch += 0x100000;
+        set_time(epoch);
+        dynamic_keymap_flush();
+    }
+
+    /* The keycode as currently persisted, bypassing the mirror. Big endian, as stored by dynamic_keymap. */
+    uint16_t stored_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapMirror, WriteIsServedFromRamUntilFlushed) {
+    TestDriver driver;
+
+    uint16_t previous = stored_keycode(0, 1, 2);
+    dynamic_keymap_set_keycode(0, 1, 2, KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_B);
+    EXPECT_EQ(stored_keycode(0, 1, 2), previous);
+
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY - 10);
+    EXPECT_EQ(stored_keycode(0, 1, 2), previous) << "Flushed before the keymap was left alone";
+
+    idle_for(20);
+    EXPECT_EQ(stored_keycode(0, 1, 2), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_B);
+}
+
+TEST_F(DynamicKeymapMirror, BurstOfWritesIsFlushedOnceSettled) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_C);
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY / 2);
+    dynamic_keymap_set_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1, KC_D);
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY / 2 + 10);
+    EXPECT_NE(stored_keycode(0, 0, 0), KC_C) << "Flush should restart with every write";
+    EXPECT_NE(stored_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_D) << "Flush should restart with every write";
+
+    // The two writes are in different blocks, which are written back on consecutive ticks
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_FLUSH_DELAY / 2 + 10);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_C);
+    EXPECT_EQ(stored_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_D);
+}
+
+TEST_F(DynamicKeymapMirror, BufferReadIncludesUnflushedWrites) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 2, 3, KC_E);
+    dynamic_keymap_set_keycode(1, 3, 9, KC_F);
+
+    uint8_t buffer[KEYMAP_BYTES];
+    dynamic_keymap_get_buffer(0, sizeof(buffer), buffer);
+    uint16_t first  = (MATRIX_ROWS * 0 + 2) * MATRIX_COLS + 3;
+    uint16_t second = (MATRIX_ROWS * 1 + 3) * MATRIX_COLS + 9;
+    EXPECT_EQ((buffer[first * 2] << 8) | buffer[first * 2 + 1], KC_E);
+    EXPECT_EQ((buffer[second * 2] << 8) | buffer[second * 2 + 1], KC_F);
+    EXPECT_NE(stored_keycode(0, 2, 3), KC_E);
+}
+
+TEST_F(DynamicKeymapMirror, BufferWriteIsFlushedOnDemand) {
+    TestDriver driver;
+
+    uint8_t buffer[KEYMAP_BYTES];
+    for (uint16_t i = 0; i < sizeof(buffer); i += 2) {
+        buffer[i]     = 0;
+        buffer[i + 1] = KC_A + (i / 2) % 26;
+    }
+    dynamic_keymap_set_buffer(0, sizeof(buffer), buffer);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 3, 9), KC_A + ((MATRIX_ROWS + 3) * MATRIX_COLS + 9) % 26);
+
+    dynamic_keymap_flush();
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(stored_keycode(layer, row, column), KC_A + ((layer * MATRIX_ROWS + row) * MATRIX_COLS + column) % 26);
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class EffectiveKeymapCache : public TestFixture {};
+
+TEST_F(EffectiveKeymapCache, TransparentKeyResolvesToLowerLayer) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(1, 1, 0, KC_C)});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EffectiveKeymapCache, LayerChangeIsPickedUp) {
+    TestDriver driver;
+    auto       layer_key   = KeymapKey(0, 0, 0, MO(1));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto       layer1_key  = KeymapKey(1, 1, 0, KC_B);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRNS), layer1_key});
+
+    /* Tap the regular key so its layer 0 resolution is cached. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Activate layer 1 and tap the same position again. */
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EffectiveKeymapCache, ReleaseUsesSourceLayer) {
+    TestDriver driver;
+    auto       layer_key   = KeymapKey(0, 0, 0, MO(1));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto       layer1_key  = KeymapKey(1, 1, 0, KC_B);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRNS), layer1_key});
+
+    /* Press the layer key and a key on layer 1. */
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release the layer key first, the held key must still release KC_B. */
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EffectiveKeymapCache, KeymapChangeInvalidatesCache) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Same position, new keycode, unchanged layer state. */
+    set_keymap({key_b});
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+}
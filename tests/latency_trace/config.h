@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Stand in for a driver that reports keyboard transfer completion
+#define LATENCY_TRACE_KEYBOARD_COMPLETION true
@@ -0,0 +1,153 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+
+    latency_trace_summary_t queued() {
+        latency_trace_summary_t summary;
+        latency_trace_get_summary(LATENCY_TRACE_QUEUED, &summary);
+        return summary;
+    }
+};
+
+TEST_F(LatencyTrace, PlainKeyIsReportedInTheSameScan) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    auto summary = queued();
+    EXPECT_EQ(summary.count, 2);
+    EXPECT_EQ(summary.min, 0);
+    EXPECT_EQ(summary.max, 0);
+    EXPECT_EQ(summary.p99, 0);
+}
+
+TEST_F(LatencyTrace, TapHoldDelayIsMeasuredFromTheScan) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+
+    set_keymap({key});
+
+    /* The press is held in the tapping buffer until the release arrives 50ms later. */
+    EXPECT_NO_REPORT(driver);
+    key.press();
+    run_one_scan_loop();
+    idle_for(49);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    auto summary = queued();
+    EXPECT_EQ(summary.count, 2);
+    EXPECT_EQ(summary.min, 0);
+    EXPECT_EQ(summary.max, 50000);
+    EXPECT_EQ(summary.avg, 25000);
+    EXPECT_EQ(summary.p99, 50000);
+}
+
+TEST_F(LatencyTrace, EventsWithoutReportsAreNotCounted) {
+    TestDriver driver;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       key       = KeymapKey(1, 1, 0, KC_B);
+
+    set_keymap({layer_key, KeymapKey(0, 1, 0, KC_A), key});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    auto summary = queued();
+    EXPECT_EQ(summary.count, 1);
+    EXPECT_EQ(summary.max, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, CompletionIsTracedFromTheQueuedReport) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Only the first transfer started after a traced report carries it. */
+    uint32_t stamp = latency_trace_report_started();
+    EXPECT_NE(stamp, 0);
+    EXPECT_EQ(latency_trace_report_started(), 0);
+
+    idle_for(3);
+    latency_trace_report_completed(stamp);
+    /* Completions of untraced transfers, such as idle retransmits, are ignored. */
+    latency_trace_report_completed(0);
+
+    latency_trace_summary_t summary;
+    latency_trace_get_summary(LATENCY_TRACE_COMPLETED, &summary);
+    EXPECT_EQ(summary.count, 1);
+    EXPECT_EQ(summary.max, 4000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, DroppedReportIsNotAwaited) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_report_dropped();
+    EXPECT_EQ(latency_trace_report_started(), 0);
+
+    latency_trace_summary_t summary;
+    latency_trace_get_summary(LATENCY_TRACE_QUEUED, &summary);
+    EXPECT_EQ(summary.count, 1);
+    latency_trace_get_summary(LATENCY_TRACE_COMPLETED, &summary);
+    EXPECT_EQ(summary.count, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define LED_MATRIX_LED_COUNT 4
+#define LED_MATRIX_SKIP_UNCHANGED_FRAMES
@@ -0,0 +1,48 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_matrix.h"
+#include "led_matrix_mock.h"
+
+// One row of four keys, each with an LED, spread across the board
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    },
+    {{0, 0}, {75, 21}, {149, 43}, {224, 64}},
+    {LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT},
+};
+
+uint8_t  mock_led_matrix_leds[LED_MATRIX_LED_COUNT];
+uint32_t mock_led_matrix_flushes = 0;
+
+static uint8_t buffer[LED_MATRIX_LED_COUNT];
+
+static void init(void) {}
+
+static void set_value(int index, uint8_t value) {
+    buffer[index] = value;
+}
+
+static void set_value_all(uint8_t value) {
+    for (int i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        set_value(i, value);
+    }
+}
+
+static void flush(void) {
+    for (int i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        mock_led_matrix_leds[i] = buffer[i];
+    }
+    mock_led_matrix_flushes++;
+}
+
+const led_matrix_driver_t led_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_value     = set_value,
+    .set_value_all = set_value_all,
+};
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// The brightness as last flushed to the LEDs
+extern uint8_t mock_led_matrix_leds[LED_MATRIX_LED_COUNT];
+// How many times the driver has been flushed
+extern uint32_t mock_led_matrix_flushes;
@@ -0,0 +1,7 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+LED_MATRIX_ENABLE = yes
+LED_MATRIX_DRIVER = custom
+
+SRC += led_matrix_mock.c
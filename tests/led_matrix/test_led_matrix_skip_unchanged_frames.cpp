@@ -0,0 +1,44 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "led_matrix.h"
+#include "led_matrix_mock.h"
+}
+
+class LedMatrixSkipUnchangedFrames : public TestFixture {
+   public:
+    void SetUp() override {
+        led_matrix_enable_noeeprom();
+        led_matrix_mode_noeeprom(LED_MATRIX_SOLID);
+        led_matrix_set_val_noeeprom(100);
+    }
+};
+
+TEST_F(LedMatrixSkipUnchangedFrames, UnchangedFrameIsNotFlushed) {
+    TestDriver driver;
+
+    // Let the first frame of the effect through
+    idle_for(100);
+    uint32_t flushes = mock_led_matrix_flushes;
+    idle_for(100);
+    EXPECT_EQ(mock_led_matrix_flushes, flushes);
+    EXPECT_NE(mock_led_matrix_leds[0], 0);
+}
+
+TEST_F(LedMatrixSkipUnchangedFrames, ChangedFrameIsFlushed) {
+    TestDriver driver;
+
+    // Let the first frame of the effect through
+    idle_for(100);
+    uint32_t flushes = mock_led_matrix_flushes;
+    uint8_t  value   = mock_led_matrix_leds[0];
+    led_matrix_set_val_noeeprom(50);
+    idle_for(100);
+    EXPECT_EQ(mock_led_matrix_flushes, flushes + 1);
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        EXPECT_LT(mock_led_matrix_leds[i], value) << "LED " << (int)i;
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include <lib/lib8tion/lib8tion.h>
+}
+
+extern const led_point_t k_rgb_matrix_center;
+
+class RgbMatrixDistanceTable : public ::testing::Test {
+   protected:
+    led_point_t saved[RGB_MATRIX_LED_COUNT];
+
+    void SetUp() override {
+        memcpy(saved, g_led_config.point, sizeof(saved));
+    }
+
+    void TearDown() override {
+        memcpy(g_led_config.point, saved, sizeof(saved));
+        rgb_matrix_init_distance_tables();
+    }
+
+    // What the effects computed every frame before the tables
+    static uint8_t distance(led_point_t a, led_point_t b) {
+        int16_t dx = a.x - b.x;
+        int16_t dy = a.y - b.y;
+        return sqrt16(dx * dx + dy * dy);
+    }
+};
+
+TEST_F(RgbMatrixDistanceTable, PackedIndexCoversEveryPairOnce) {
+    std::vector<int> uses(sizeof(g_rgb_led_distance), 0);
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        for (uint8_t b = a + 1; b < RGB_MATRIX_LED_COUNT; b++) {
+            // Give every pair a distinct entry, then find which one it reads
+            memset(g_rgb_led_distance, 0, sizeof(g_rgb_led_distance));
+            size_t found = sizeof(g_rgb_led_distance);
+            for (size_t i = 0; i < sizeof(g_rgb_led_distance); i++) {
+                g_rgb_led_distance[i] = 1;
+                if (rgb_matrix_led_distance(a, b) == 1) {
+                    found = i;
+                    EXPECT_EQ(rgb_matrix_led_distance(b, a), 1) << "Lookup is not symmetric for " << (int)a << ", " << (int)b;
+                    break;
+                }
+                g_rgb_led_distance[i] = 0;
+            }
+            ASSERT_LT(found, sizeof(g_rgb_led_distance)) << "No entry for " << (int)a << ", " << (int)b;
+            uses[found]++;
+        }
+    }
+    for (size_t i = 0; i < uses.size(); i++) {
+        EXPECT_EQ(uses[i], 1) << "Entry " << i;
+    }
+}
+
+TEST_F(RgbMatrixDistanceTable, TablesMatchDirectComputation) {
+    uint32_t rng = 1;
+    for (int trial = 0; trial < 256; trial++) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            rng                     = rng * 1103515245 + 12345;
+            g_led_config.point[i].x = (rng >> 8) % 225;
+            g_led_config.point[i].y = (rng >> 20) % 65;
+        }
+        // The extremes of the coordinate space, which give the longest distances
+        g_led_config.point[0] = (led_point_t){0, 0};
+        g_led_config.point[1] = (led_point_t){224, 64};
+        rgb_matrix_init_distance_tables();
+
+        for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+            ASSERT_EQ(rgb_matrix_center_distance(a), distance(g_led_config.point[a], k_rgb_matrix_center)) << "LED " << (int)a;
+            for (uint8_t b = 0; b < RGB_MATRIX_LED_COUNT; b++) {
+                ASSERT_EQ(rgb_matrix_led_distance(a, b), distance(g_led_config.point[a], g_led_config.point[b])) << "LEDs " << (int)a << ", " << (int)b;
+            }
+        }
+    }
+}
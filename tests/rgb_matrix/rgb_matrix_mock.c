@@ -0,0 +1,50 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "rgb_matrix_mock.h"
+
+// One row of four keys, each with an LED, spread across the board
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    },
+    {{0, 0}, {75, 21}, {149, 43}, {224, 64}},
+    {LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT},
+};
+
+RGB      mock_rgb_matrix_leds[RGB_MATRIX_LED_COUNT];
+uint32_t mock_rgb_matrix_flushes = 0;
+
+static RGB buffer[RGB_MATRIX_LED_COUNT];
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    buffer[index].r = r;
+    buffer[index].g = g;
+    buffer[index].b = b;
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+static void flush(void) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        mock_rgb_matrix_leds[i] = buffer[i];
+    }
+    mock_rgb_matrix_flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
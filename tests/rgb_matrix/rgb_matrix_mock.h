@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+// The colors as last flushed to the LEDs
+extern RGB mock_rgb_matrix_leds[RGB_MATRIX_LED_COUNT];
+// How many times the driver has been flushed
+extern uint32_t mock_rgb_matrix_flushes;
@@ -0,0 +1,55 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "../rgb_matrix_mock.h"
+}
+
+class RgbMatrixSkipUnchangedFrames : public TestFixture {
+   public:
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    }
+};
+
+TEST_F(RgbMatrixSkipUnchangedFrames, UnchangedFrameIsNotFlushed) {
+    TestDriver driver;
+
+    // Let the first frame of the effect through
+    idle_for(100);
+    uint32_t flushes = mock_rgb_matrix_flushes;
+    idle_for(100);
+    EXPECT_EQ(mock_rgb_matrix_flushes, flushes);
+    EXPECT_EQ(mock_rgb_matrix_leds[0].r, 255);
+}
+
+TEST_F(RgbMatrixSkipUnchangedFrames, ChangedFrameIsFlushed) {
+    TestDriver driver;
+
+    // Let the first frame of the effect through
+    idle_for(100);
+    uint32_t flushes = mock_rgb_matrix_flushes;
+    rgb_matrix_sethsv_noeeprom(170, 255, 255);
+    idle_for(100);
+    EXPECT_EQ(mock_rgb_matrix_flushes, flushes + 1);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(mock_rgb_matrix_leds[i].r, 0) << "LED " << (int)i;
+        EXPECT_EQ(mock_rgb_matrix_leds[i].b, 255) << "LED " << (int)i;
+    }
+}
+
+TEST_F(RgbMatrixSkipUnchangedFrames, ForcedFlushIsSentEvenIfUnchanged) {
+    TestDriver driver;
+
+    // Let the first frame of the effect through
+    idle_for(100);
+    uint32_t flushes = mock_rgb_matrix_flushes;
+    rgb_matrix_flush_deferred();
+    idle_for(100);
+    EXPECT_EQ(mock_rgb_matrix_flushes, flushes + 1);
+}
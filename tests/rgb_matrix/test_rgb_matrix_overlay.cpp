@@ -0,0 +1,74 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "rgb_matrix_mock.h"
+}
+
+class RgbMatrixOverlay : public TestFixture {
+   public:
+    void SetUp() override {
+        rgb_matrix_set_suspend_state(false);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(0, 0, 0);
+
+        rgb_matrix_overlay_clear(0);
+        rgb_matrix_overlay_set_color(0, 0, 0, 200);
+        rgb_matrix_overlay_set_blend(0, RGB_MATRIX_BLEND_REPLACE, 0);
+        rgb_matrix_overlay_set_led(0, 1, true);
+        rgb_matrix_overlay_enable(0);
+    }
+
+    void TearDown() override {
+        rgb_matrix_overlay_disable(0);
+        rgb_matrix_set_suspend_state(false);
+        rgb_matrix_enable_noeeprom();
+    }
+
+    void expect_dark(void) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            EXPECT_EQ(mock_rgb_matrix_leds[i].r, 0) << "LED " << (int)i;
+            EXPECT_EQ(mock_rgb_matrix_leds[i].g, 0) << "LED " << (int)i;
+            EXPECT_EQ(mock_rgb_matrix_leds[i].b, 0) << "LED " << (int)i;
+        }
+    }
+};
+
+TEST_F(RgbMatrixOverlay, AppliesToRunningEffect) {
+    TestDriver driver;
+
+    idle_for(100);
+    EXPECT_EQ(mock_rgb_matrix_leds[1].b, 200);
+    EXPECT_EQ(mock_rgb_matrix_leds[0].b, 0);
+    EXPECT_EQ(mock_rgb_matrix_leds[2].b, 0);
+}
+
+TEST_F(RgbMatrixOverlay, IsDarkWhileMatrixIsOff) {
+    TestDriver driver;
+
+    idle_for(100);
+    rgb_matrix_disable_noeeprom();
+    idle_for(100);
+    expect_dark();
+
+    rgb_matrix_enable_noeeprom();
+    idle_for(100);
+    EXPECT_EQ(mock_rgb_matrix_leds[1].b, 200);
+}
+
+TEST_F(RgbMatrixOverlay, IsDarkWhileSuspended) {
+    TestDriver driver;
+
+    idle_for(100);
+    rgb_matrix_set_suspend_state(true);
+    idle_for(100);
+    expect_dark();
+
+    rgb_matrix_set_suspend_state(false);
+    idle_for(100);
+    EXPECT_EQ(mock_rgb_matrix_leds[1].b, 200);
+}
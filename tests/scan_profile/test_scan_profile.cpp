@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "scan_profile.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::InSequence;
+
+class ScanProfile : public TestFixture {
+   public:
+    void SetUp() override {
+        scan_profile_reset();
+    }
+
+    uint32_t samples(scan_profile_stage_t stage) {
+        uint32_t total = 0;
+        for (uint8_t bucket = 0; bucket < SCAN_PROFILE_BUCKETS; bucket++) {
+            total += scan_profile_get_bucket(stage, bucket);
+        }
+        return total;
+    }
+};
+
+TEST_F(ScanProfile, SamplesLandInLog2Buckets) {
+    uint32_t start = scan_profile_now();
+    scan_profile_record(SCAN_PROFILE_QUANTUM_TASK, start);
+    EXPECT_EQ(scan_profile_get_bucket(SCAN_PROFILE_QUANTUM_TASK, 0), 1);
+
+    start = scan_profile_now();
+    advance_time(5);
+    scan_profile_record(SCAN_PROFILE_QUANTUM_TASK, start);
+    EXPECT_EQ(scan_profile_get_bucket(SCAN_PROFILE_QUANTUM_TASK, 3), 1);
+    EXPECT_EQ(scan_profile_get_max(SCAN_PROFILE_QUANTUM_TASK), 5);
+
+    start = scan_profile_now();
+    advance_time(100000);
+    scan_profile_record(SCAN_PROFILE_QUANTUM_TASK, start);
+    EXPECT_EQ(scan_profile_get_bucket(SCAN_PROFILE_QUANTUM_TASK, SCAN_PROFILE_BUCKETS - 1), 1);
+    EXPECT_EQ(scan_profile_get_max(SCAN_PROFILE_QUANTUM_TASK), 100000);
+
+    EXPECT_EQ(samples(SCAN_PROFILE_QUANTUM_TASK), 3);
+    EXPECT_EQ(samples(SCAN_PROFILE_ACTION_EXEC), 0);
+}
+
+TEST_F(ScanProfile, ResetClearsHistograms) {
+    uint32_t start = scan_profile_now();
+    advance_time(2);
+    scan_profile_record(SCAN_PROFILE_DEBOUNCE, start);
+    EXPECT_EQ(samples(SCAN_PROFILE_DEBOUNCE), 1);
+
+    scan_profile_reset();
+    EXPECT_EQ(samples(SCAN_PROFILE_DEBOUNCE), 0);
+    EXPECT_EQ(scan_profile_get_max(SCAN_PROFILE_DEBOUNCE), 0);
+}
+
+TEST_F(ScanProfile, OutOfRangeQueriesReturnZero) {
+    EXPECT_EQ(scan_profile_get_bucket(SCAN_PROFILE_STAGE_COUNT, 0), 0);
+    EXPECT_EQ(scan_profile_get_bucket(SCAN_PROFILE_KEYBOARD_TASK, SCAN_PROFILE_BUCKETS), 0);
+    EXPECT_EQ(scan_profile_get_max(SCAN_PROFILE_STAGE_COUNT), 0);
+}
+
+TEST_F(ScanProfile, ScanLoopRecordsEachStage) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    uint32_t loops = samples(SCAN_PROFILE_KEYBOARD_TASK);
+    EXPECT_GE(loops, 2);
+    EXPECT_EQ(samples(SCAN_PROFILE_MATRIX_SCAN), loops);
+    EXPECT_EQ(samples(SCAN_PROFILE_QUANTUM_TASK), loops);
+    EXPECT_EQ(samples(SCAN_PROFILE_ACTION_EXEC), 2);
+    EXPECT_EQ(samples(SCAN_PROFILE_HOST_KEYBOARD_SEND), 2);
+}
@@ -99,6 +99,7 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+    effective_keymap_invalidate();
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
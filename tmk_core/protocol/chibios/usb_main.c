@@ -45,6 +45,10 @@
 #include "usb_driver.h"
 #include "usb_types.h"
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 
@@ -134,13 +138,33 @@ static void dummy_usb_cb(USBDriver *usbp, usbep_t ep) {
 }
 
 #ifndef KEYBOARD_SHARED_EP
+#    ifdef LATENCY_TRACE_ENABLE
+/* stamp of the traced report carried by the current keyboard IN transfer, zero if untraced */
+static volatile uint32_t kbd_in_stamp = 0;
+
+/*
+ * Keyboard IN notification callback, runs in ISR context once the host has
+ * collected a report.
+ */
+static void kbd_in_cb(USBDriver *usbp, usbep_t ep) {
+    (void)usbp;
+    (void)ep;
+    uint32_t stamp = kbd_in_stamp;
+    kbd_in_stamp   = 0;
+    latency_trace_report_completed(stamp);
+}
+#        define KBD_IN_CB kbd_in_cb
+#    else
+#        define KBD_IN_CB dummy_usb_cb
+#    endif
+
 /* keyboard endpoint state structure */
 static USBInEndpointState kbd_ep_state;
 /* keyboard endpoint initialization structure (IN) - see USBEndpointConfig comment at top of file */
 static const USBEndpointConfig kbd_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    KBD_IN_CB,              /* IN notification callback */
     NULL,                   /* OUT notification callback */
     KEYBOARD_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -826,6 +850,10 @@ static void keyboard_idle_timer_cb(struct ch_virtual_timer *timer, void *arg) {
 #endif /* NKRO_ENABLE */
         /* TODO: are we sure we want the KBD_ENDPOINT? */
         if (!usbGetTransmitStatusI(usbp, KEYBOARD_IN_EPNUM)) {
+#if defined(LATENCY_TRACE_ENABLE) && !defined(KEYBOARD_SHARED_EP)
+            /* a retransmit, its completion says nothing about the traced report */
+            kbd_in_stamp = 0;
+#endif
             usbStartTransmitI(usbp, KEYBOARD_IN_EPNUM, (uint8_t *)&keyboard_report_sent, KEYBOARD_EPSIZE);
         }
         /* rearm the timer */
@@ -842,9 +870,20 @@ uint8_t keyboard_leds(void) {
     return keyboard_led_state;
 }
 
+#if defined(LATENCY_TRACE_ENABLE) && !defined(KEYBOARD_SHARED_EP)
+static inline void kbd_in_trace_dropped(uint8_t endpoint) {
+    if (endpoint == KEYBOARD_IN_EPNUM) {
+        latency_trace_report_dropped();
+    }
+}
+#else
+#    define kbd_in_trace_dropped(endpoint)
+#endif
+
 void send_report(uint8_t endpoint, void *report, size_t size) {
     osalSysLock();
     if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+        kbd_in_trace_dropped(endpoint);
         osalSysUnlock();
         return;
     }
@@ -855,10 +894,16 @@ void send_report(uint8_t endpoint, void *report, size_t size) {
          * no interrupts served, so USB not going through as well.
          * Note: for suspend, need USB_USE_WAIT == TRUE in halconf.h */
         if (osalThreadSuspendTimeoutS(&(&USB_DRIVER)->epc[endpoint]->in_state->thread, TIME_MS2I(10)) == MSG_TIMEOUT) {
+            kbd_in_trace_dropped(endpoint);
             osalSysUnlock();
             return;
         }
     }
+#if defined(LATENCY_TRACE_ENABLE) && !defined(KEYBOARD_SHARED_EP)
+    if (endpoint == KEYBOARD_IN_EPNUM) {
+        kbd_in_stamp = latency_trace_report_started();
+    }
+#endif
     usbStartTransmitI(&USB_DRIVER, endpoint, report, size);
     osalSysUnlock();
 }
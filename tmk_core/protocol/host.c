@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "scan_profile.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -40,6 +41,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 extern keymap_config_t keymap_config;
 #endif
 
+#if defined(LATENCY_TRACE_ENABLE) && !defined(LATENCY_TRACE_KEYBOARD_COMPLETION)
+// Only the ChibiOS driver reports completion, and only on a dedicated keyboard endpoint
+#    if defined(PROTOCOL_CHIBIOS) && !defined(KEYBOARD_SHARED_EP)
+#        define LATENCY_TRACE_KEYBOARD_COMPLETION true
+#    else
+#        define LATENCY_TRACE_KEYBOARD_COMPLETION false
+#    endif
+#endif
+
 static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
@@ -84,7 +94,12 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_queued(LATENCY_TRACE_KEYBOARD_COMPLETION);
+#endif
+    SCAN_PROFILE_BEGIN(send_start);
     (*driver->send_keyboard)(report);
+    SCAN_PROFILE_END(SCAN_PROFILE_HOST_KEYBOARD_SEND, send_start);
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -98,6 +113,9 @@ void host_keyboard_send(report_keyboard_t *report) {
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_queued(false);
+#endif
     (*driver->send_nkro)(report);
 
     if (debug_keyboard) {